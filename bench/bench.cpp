@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "./benchmark.h"
+#include "./game/game.h"
+#include "./stateGraph/stateGraph.h"
+#include "./util/base64.h"
+
+namespace Bench {
+
+const static std::vector<std::pair<std::string, std::function<Result()>>>
+    Benchmarks = {
+        {"Game::DoMove", Game::DoMove},
+        {"Game::SetValidMoves", Game::SetValidMoves},
+        {"Game::Serialize", Game::Serialize},
+        {"Game::FromSerialization", Game::FromSerialization},
+
+        {"StateGraph::Hash", StateGraph::Hash},
+        {"StateGraph::EqualTo", StateGraph::EqualTo},
+        {"StateGraph::Graph::Save", StateGraph::Save},
+        {"StateGraph::Graph::Load", StateGraph::Load},
+        {"StateGraph::Strategies::RetrogradeAnalyse",
+         StateGraph::RetrogradeAnalyse},
+
+        {"Base64::Encode", Base64::Encode},
+        {"Base64::Decode", Base64::Decode},
+};
+
+static std::string ToLower(std::string string) {
+  std::transform(string.begin(), string.end(), string.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return string;
+}
+
+static void PrintJson(const std::vector<Result>& results) {
+  std::cout << "{\n";
+  std::cout << std::format("  \"version\": \"{}\",\n", VERSION);
+  std::cout << "  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    std::cout << (i == 0 ? "\n" : ",\n");
+    std::cout << std::format(
+        "    {{\"name\": \"{}\", \"iterations\": {}, \"operations\": {}, "
+        "\"median_ns\": {:.1f}, \"min_ns\": {:.1f}}}",
+        result.Name, result.Iterations, result.Operations,
+        result.MedianNanoseconds, result.MinNanoseconds);
+  }
+
+  std::cout << "\n  ]\n}" << std::endl;
+}
+
+static void PrintCsv(const std::vector<Result>& results) {
+  std::cout << "name,iterations,operations,median_ns,min_ns\n";
+  for (const Result& result : results) {
+    std::cout << std::format("{},{},{},{:.1f},{:.1f}\n", result.Name,
+                             result.Iterations, result.Operations,
+                             result.MedianNanoseconds, result.MinNanoseconds);
+  }
+  std::cout << std::flush;
+}
+
+void Init() {
+  Game::Init();
+  StateGraph::Init();
+}
+
+void Cleanup() { StateGraph::Cleanup(); }
+
+}  // namespace Bench
+
+// Usage: onitama-bench [--csv] [filter]...
+// Runs every benchmark whose name contains one of the filters,
+// or all benchmarks if none are given
+int main(int argc, char* argv[]) {
+  bool csv = false;
+  std::vector<std::string> filters;
+  for (int arg = 1; arg < argc; arg++) {
+    const std::string argument(argv[arg]);
+    if (argument == "--csv") {
+      csv = true;
+    } else {
+      filters.push_back(Bench::ToLower(argument));
+    }
+  }
+
+  // The code under measurement reports its progress on stdout,
+  // which is reserved for the results
+  std::ostringstream discarded;
+  std::streambuf* const stdoutBuffer = std::cout.rdbuf(discarded.rdbuf());
+
+  Bench::Init();
+
+  std::vector<Bench::Result> results;
+  for (const auto& [name, benchmark] : Bench::Benchmarks) {
+    const std::string loweredName = Bench::ToLower(name);
+    const bool selected =
+        filters.empty() ||
+        std::any_of(filters.begin(), filters.end(),
+                    [&](const std::string& filter) {
+                      return loweredName.find(filter) != std::string::npos;
+                    });
+    if (!selected) continue;
+
+    std::cerr << std::format("Running benchmark \"{}\"...", name) << std::endl;
+    results.push_back(benchmark());
+    discarded.str("");
+  }
+
+  Bench::Cleanup();
+  std::cout.rdbuf(stdoutBuffer);
+
+  if (results.empty()) {
+    std::cerr << "No benchmarks matched!" << std::endl;
+    return 1;
+  }
+
+  if (csv) {
+    Bench::PrintCsv(results);
+  } else {
+    Bench::PrintJson(results);
+  }
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Bench {
+
+using Clock = std::chrono::steady_clock;
+
+static Clock::duration RunBatch(const std::function<void()>& body,
+                                const std::function<void()>& setup,
+                                const size_t iterations) {
+  if (!setup) {
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) body();
+    return Clock::now() - start;
+  }
+
+  Clock::duration total = Clock::duration::zero();
+  for (size_t i = 0; i < iterations; i++) {
+    setup();
+
+    const Clock::time_point start = Clock::now();
+    body();
+    total += Clock::now() - start;
+  }
+
+  return total;
+}
+
+Result Measure(const std::string& name, const std::function<void()>& body,
+               const size_t operations, const std::function<void()>& setup) {
+  // Double the batch size until a single batch fills a sample,
+  // which doubles as a warm-up
+  size_t iterations = 1;
+  while (RunBatch(body, setup, iterations) < SAMPLE_TIME) iterations *= 2;
+
+  std::vector<double> samples;
+  samples.reserve(SAMPLE_COUNT);
+  for (size_t sample = 0; sample < SAMPLE_COUNT; sample++) {
+    const std::chrono::duration<double, std::nano> duration =
+        RunBatch(body, setup, iterations);
+    samples.push_back(duration.count() / (iterations * operations));
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  return Result{
+      .Name = name,
+      .Iterations = iterations,
+      .Operations = operations,
+      .MedianNanoseconds = samples[samples.size() / 2],
+      .MinNanoseconds = samples.front(),
+  };
+}
+
+}  // namespace Bench
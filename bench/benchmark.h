@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace Bench {
+
+using namespace std::chrono_literals;
+
+constexpr size_t SAMPLE_COUNT = 5;
+constexpr std::chrono::nanoseconds SAMPLE_TIME = 50ms;
+
+struct Result {
+  std::string Name;
+
+  // Calls to the benchmark body per sample
+  size_t Iterations;
+  // Operations performed by a single call to the benchmark body
+  size_t Operations;
+
+  double MedianNanoseconds;
+  double MinNanoseconds;
+};
+
+// Keeps the compiler from discarding the computation of `value`
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static const void* volatile sink;
+  sink = &value;
+#endif
+}
+
+// Times `body` over SAMPLE_COUNT samples of at least SAMPLE_TIME each,
+// reporting the time per operation.
+// If `setup` is given, it is called before every call to `body`,
+// and is excluded from the measurement.
+Result Measure(const std::string& name, const std::function<void()>& body,
+               const size_t operations = 1,
+               const std::function<void()>& setup = nullptr);
+
+}  // namespace Bench
@@ -0,0 +1,110 @@
+#include "game.h"
+
+#include <optional>
+#include <random>
+
+namespace Bench {
+namespace Game {
+
+using namespace ::Game;
+
+static constexpr size_t POSITION_COUNT = 256;
+static constexpr size_t MAX_PLAYOUT_PLIES = 24;
+static constexpr uint32_t PLAYOUT_SEED = 0;
+
+static constexpr std::array<Card, CARD_COUNT> Cards = {
+    Card(CardType::Ox), Card(CardType::Boar), Card(CardType::Elephant),
+    Card(CardType::Horse), Card(CardType::Mantis)};
+
+static std::vector<::Game::Game> Positions;
+
+// A line of play from the initial position, for DoMove
+static std::vector<Move> Line;
+
+const std::vector<::Game::Game>& GetPositions() { return Positions; }
+
+void Init() {
+  std::mt19937 generator(PLAYOUT_SEED);
+
+  Positions.reserve(POSITION_COUNT);
+  while (Positions.size() < POSITION_COUNT) {
+    ::Game::Game game(5, 5, Cards);
+    const size_t plies = std::uniform_int_distribution<size_t>(
+        0, MAX_PLAYOUT_PLIES)(generator);
+
+    for (size_t ply = 0; ply < plies; ply++) {
+      const std::vector<Move>& moves = game.GetValidMoves();
+      const Move move = moves[std::uniform_int_distribution<size_t>(
+          0, moves.size() - 1)(generator)];
+
+      if (Positions.empty()) Line.push_back(move);
+      game.DoMove(move);
+
+      if (game.IsFinished().has_value()) break;
+    }
+
+    if (!game.IsFinished().has_value()) Positions.push_back(game);
+  }
+}
+
+Result DoMove() {
+  std::optional<::Game::Game> game;
+
+  return Measure(
+      "Game::DoMove",
+      [&]() {
+        for (const Move move : Line) game->DoMove(move);
+        DoNotOptimize(*game);
+      },
+      Line.size(), [&]() { game.emplace(5, 5, Cards); });
+}
+
+// SetValidMoves is private, so it is measured through the constructor that
+// takes a ready board
+Result SetValidMoves() {
+  std::vector<Board> boards;
+
+  return Measure(
+      "Game::SetValidMoves",
+      [&]() {
+        for (size_t i = 0; i < Positions.size(); i++) {
+          const ::Game::Game game(std::move(boards[i]),
+                                  std::array<Card, CARD_COUNT>(Cards),
+                                  Positions[i].GetCurrentPlayer());
+          DoNotOptimize(game);
+        }
+      },
+      Positions.size(),
+      [&]() {
+        boards.clear();
+        for (const ::Game::Game& position : Positions)
+          boards.push_back(position.GetBoard());
+      });
+}
+
+Result Serialize() {
+  return Measure(
+      "Game::Serialize",
+      []() {
+        for (const ::Game::Game& position : Positions)
+          DoNotOptimize(position.Serialize());
+      },
+      Positions.size());
+}
+
+Result FromSerialization() {
+  std::vector<GameSerialization> serializations;
+  for (const ::Game::Game& position : Positions)
+    serializations.push_back(position.Serialize());
+
+  return Measure(
+      "Game::FromSerialization",
+      [&]() {
+        for (const GameSerialization& serialization : serializations)
+          DoNotOptimize(::Game::Game::FromSerialization(serialization));
+      },
+      serializations.size());
+}
+
+}  // namespace Game
+}  // namespace Bench
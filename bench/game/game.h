@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "../../src/game/game.h"
+#include "../benchmark.h"
+
+namespace Bench {
+namespace Game {
+
+// Positions reached by seeded random playouts on a fixed 5x5 deal
+const std::vector<::Game::Game>& GetPositions();
+
+void Init();
+
+Result DoMove();
+Result SetValidMoves();
+Result Serialize();
+Result FromSerialization();
+
+}  // namespace Game
+}  // namespace Bench
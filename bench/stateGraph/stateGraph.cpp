@@ -0,0 +1,115 @@
+#include "stateGraph.h"
+
+#include <deque>
+#include <filesystem>
+
+#include "../../src/stateGraph/strategies.h"
+#include "../game/game.h"
+
+namespace Bench {
+namespace StateGraph {
+
+using namespace ::StateGraph;
+
+// An unsolved graph of the first GRAPH_SIZE vertices expanded in breadth
+// first order from a fixed 5x5 deal
+static constexpr size_t GRAPH_WIDTH = 5;
+static constexpr size_t GRAPH_HEIGHT = 5;
+static constexpr size_t GRAPH_SIZE = 1000;
+static constexpr std::array<::Game::Card, CARD_COUNT> GraphCards = {
+    ::Game::Card(::Game::CardType::Crab),
+    ::Game::Card(::Game::CardType::Mantis),
+    ::Game::Card(::Game::CardType::Ox),
+    ::Game::Card(::Game::CardType::Boar),
+    ::Game::Card(::Game::CardType::Goose)};
+
+static Graph ExploredGraph;
+static const std::filesystem::path GraphPath =
+    std::filesystem::temp_directory_path() / "onitama-bench.graph";
+
+// Complete components are out of reach, even on small boards,
+// so the graph is cut off after a fixed number of expansions instead
+static void ExploreGraph() {
+  const ::Game::Game root(GRAPH_WIDTH, GRAPH_HEIGHT, GraphCards);
+  std::deque<std::shared_ptr<Vertex>> queue = {
+      ExploredGraph.Vertices.emplace(root, std::make_shared<Vertex>(root))
+          .first->second};
+
+  for (size_t expanded = 0; expanded < GRAPH_SIZE && !queue.empty();
+       expanded++) {
+    const std::shared_ptr<Vertex> vertex = queue.front();
+    queue.pop_front();
+
+    const ::Game::Game game =
+        ::Game::Game::FromSerialization(vertex->Serialization);
+    if (game.IsFinished().has_value()) continue;
+
+    for (const ::Game::Move move : game.GetValidMoves()) {
+      ::Game::Game nextState = game;
+      nextState.DoMove(move);
+
+      const auto [it, inserted] = ExploredGraph.Vertices.emplace(
+          nextState, std::make_shared<Vertex>(nextState));
+      if (inserted) queue.push_back(it->second);
+
+      vertex->Edges.emplace_back(
+          std::make_shared<Edge>(vertex, it->second, move));
+    }
+  }
+}
+
+void Init() {
+  ExploreGraph();
+  ExploredGraph.Save(GraphPath);
+}
+
+void Cleanup() { std::filesystem::remove(GraphPath); }
+
+Result Hash() {
+  const std::vector<::Game::Game>& positions = Game::GetPositions();
+
+  return Measure(
+      "StateGraph::Hash",
+      [&]() {
+        for (const ::Game::Game& position : positions)
+          DoNotOptimize(::StateGraph::Hash()(position));
+      },
+      positions.size());
+}
+
+// Compares each position against a copy of itself,
+// so that every comparison runs to completion
+Result EqualTo() {
+  const std::vector<::Game::Game>& positions = Game::GetPositions();
+  const std::vector<::Game::Game> copies = positions;
+
+  return Measure(
+      "StateGraph::EqualTo",
+      [&]() {
+        for (size_t i = 0; i < positions.size(); i++)
+          DoNotOptimize(::StateGraph::EqualTo()(positions[i], copies[i]));
+      },
+      positions.size());
+}
+
+Result Save() {
+  return Measure("StateGraph::Graph::Save",
+                 []() { ExploredGraph.Save(GraphPath); });
+}
+
+Result Load() {
+  return Measure("StateGraph::Graph::Load",
+                 []() { DoNotOptimize(Graph::Load(GraphPath)); });
+}
+
+Result RetrogradeAnalyse() {
+  Graph graph;
+
+  return Measure(
+      "StateGraph::Strategies::RetrogradeAnalyse",
+      [&]() { Strategies::RetrogradeAnalyse(graph); }, 1,
+      [&]() { graph = Graph::Load(GraphPath).first; });
+}
+
+}  // namespace StateGraph
+}  // namespace Bench
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../../src/stateGraph/stateGraph.h"
+#include "../benchmark.h"
+
+namespace Bench {
+namespace StateGraph {
+
+void Init();
+void Cleanup();
+
+Result Hash();
+Result EqualTo();
+Result Save();
+Result Load();
+Result RetrogradeAnalyse();
+
+}  // namespace StateGraph
+}  // namespace Bench
@@ -0,0 +1,39 @@
+#include "base64.h"
+
+#include "../../src/util/base64.h"
+#include "../game/game.h"
+
+namespace Bench {
+namespace Base64 {
+
+Result Encode() {
+  std::vector<::Game::GameSerialization> serializations;
+  for (const ::Game::Game& position : Game::GetPositions())
+    serializations.push_back(position.Serialize());
+
+  return Measure(
+      "Base64::Encode",
+      [&]() {
+        for (const ::Game::GameSerialization& serialization : serializations)
+          DoNotOptimize(::Base64::Encode(serialization));
+      },
+      serializations.size());
+}
+
+Result Decode() {
+  std::vector<std::string> strings;
+  for (const ::Game::Game& position : Game::GetPositions())
+    strings.push_back(::Base64::Encode(position.Serialize()));
+
+  return Measure(
+      "Base64::Decode",
+      [&]() {
+        for (const std::string& string : strings)
+          DoNotOptimize(
+              ::Base64::Decode<::Game::GAME_SERIALIZATION_SIZE>(string));
+      },
+      strings.size());
+}
+
+}  // namespace Base64
+}  // namespace Bench
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../benchmark.h"
+
+namespace Bench {
+namespace Base64 {
+
+Result Encode();
+Result Decode();
+
+}  // namespace Base64
+}  // namespace Bench
@@ -0,0 +1,261 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <random>
+
+#include "../strategies/random.h"
+#include "../util/memory.h"
+
+namespace Cli {
+
+double StrategyBenchResults::GetMovesPerSecond() const {
+  const double seconds = ThinkingTime.count();
+  return seconds > 0.0 ? GetMoveCount() / seconds : 0.0;
+}
+
+std::chrono::duration<double> StrategyBenchResults::GetLatencyPercentile(
+    const double percentile) const {
+  if (Latencies.empty()) return std::chrono::duration<double>::zero();
+
+  // Nearest rank
+  const size_t rank =
+      (size_t)std::ceil(percentile / 100.0 * Latencies.size());
+  return Latencies[std::clamp<size_t>(rank, 1, Latencies.size()) - 1];
+}
+
+// Plays a seeded number of random plies from a seeded deal, short of ending the
+// game
+static Game::Game GetBenchPosition(const StrategyBenchArgs& args,
+                                   const uint32_t seed) {
+  const Parse::GameConfiguration configuration{.Dimensions = args.Dimensions};
+  Game::Game game = configuration.ToGame(seed).value();
+
+  Strategy::Random random(seed);
+  const size_t plies = std::mt19937(seed)() % (BENCH_POSITION_MAX_PLIES + 1);
+  for (size_t ply = 0; ply < plies; ply++) {
+    const Game::Move move = random.GetMove(game, {});
+
+    Game::Game nextGame(game);
+    nextGame.DoMove(move);
+    if (nextGame.IsFinished()) break;
+
+    game.DoMove(move);
+  }
+
+  return game;
+}
+
+StrategyBenchResults ExecuteStrategyBench(const StrategyBenchArgs& args) {
+  StrategyBenchResults results;
+
+  for (size_t positionId = 0; positionId < args.PositionCount; positionId++) {
+    const Game::Game game = GetBenchPosition(args, args.Seed + positionId);
+    std::unique_ptr<Strategy::Strategy> strategy = args.Strategy();
+
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    Strategy::SearchLimits limits;
+    if (args.MoveTime) limits.Deadline = start + args.MoveTime.value();
+
+    strategy->GetMove(game, limits);
+    const std::chrono::duration<double> latency =
+        std::chrono::steady_clock::now() - start;
+
+    results.Latencies.push_back(latency);
+    results.ThinkingTime += latency;
+    results.NodeCount += strategy->GetNodeCount();
+  }
+
+  for (size_t gameId = 0; gameId < args.GameCount; gameId++) {
+    const uint32_t seed = args.Seed + gameId;
+    const Parse::GameConfiguration configuration{.Dimensions =
+                                                     args.Dimensions};
+    Game::Game game = configuration.ToGame(seed).value();
+
+    std::unique_ptr<Strategy::Strategy> strategy = args.Strategy();
+    std::unique_ptr<Strategy::Strategy> reference =
+        args.Reference ? args.Reference->second()
+                       : std::make_unique<Strategy::Random>(seed);
+
+    // Alternate colours, so that neither side of the deal is favoured
+    const Color color = gameId % 2 == 0 ? Color::Red : Color::Blue;
+
+    for (size_t ply = 0; ply < BENCH_MAX_PLIES && !game.IsFinished(); ply++) {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+
+      Strategy::SearchLimits limits;
+      if (args.MoveTime) limits.Deadline = start + args.MoveTime.value();
+
+      if (game.GetCurrentPlayer() != color) {
+        game.DoMove(reference->GetMove(game, limits));
+        continue;
+      }
+
+      const Game::Move move = strategy->GetMove(game, limits);
+      const std::chrono::duration<double> latency =
+          std::chrono::steady_clock::now() - start;
+
+      results.Latencies.push_back(latency);
+      results.ThinkingTime += latency;
+      game.DoMove(move);
+    }
+
+    results.NodeCount += strategy->GetNodeCount();
+
+    const std::optional<Color> winner = game.IsFinished();
+    if (!winner) {
+      results.Record.Draws++;
+    } else if (winner == color) {
+      results.Record.Wins++;
+    } else {
+      results.Record.Losses++;
+    }
+  }
+
+  std::sort(results.Latencies.begin(), results.Latencies.end());
+  results.PeakMemory = Memory::GetPeakResidentMemory();
+
+  return results;
+}
+
+void PrintStrategyBenchResults(const StrategyBenchArgs& args,
+                               const StrategyBenchResults& results) {
+  const auto milliseconds = [&results](const double percentile) {
+    return results.GetLatencyPercentile(percentile).count() * 1000.0;
+  };
+
+  std::cout << std::format("Benchmarked \"{}\" in {} positions and against "
+                           "\"{}\" in {} games of {}x{} (seed {}).",
+                           args.Name, args.PositionCount,
+                           args.Reference ? args.Reference->first : "random",
+                           args.GameCount, args.Dimensions.first,
+                           args.Dimensions.second, args.Seed)
+            << std::endl
+            << std::format("Moves: {} in {:.3f}s ({:.1f} moves/s).",
+                           results.GetMoveCount(),
+                           results.ThinkingTime.count(),
+                           results.GetMovesPerSecond())
+            << std::endl
+            << std::format("Latency: p50 {:.3f}ms, p95 {:.3f}ms, p99 "
+                           "{:.3f}ms, max {:.3f}ms.",
+                           milliseconds(50), milliseconds(95),
+                           milliseconds(99), milliseconds(100))
+            << std::endl;
+
+  const double seconds = results.ThinkingTime.count();
+  std::cout << std::format("Nodes: {} ({:.1f} nodes/s).", results.NodeCount,
+                           seconds > 0.0 ? results.NodeCount / seconds : 0.0)
+            << std::endl;
+
+  if (results.PeakMemory) {
+    std::cout << std::format("Peak memory: {:.1f} MiB.",
+                             results.PeakMemory.value() / 1048576.0)
+              << std::endl;
+  }
+
+  std::cout << std::format("Results: {}-{}-{}.", results.Record.Wins,
+                           results.Record.Draws, results.Record.Losses)
+            << std::endl;
+}
+
+std::optional<Thunk> BenchCommand::Parse(std::istringstream& command) const {
+  if (Parse::ParseHelp(command))
+    return [this] { std::cout << GetHelp() << std::endl; };
+
+  std::string subCommand;
+  command >> subCommand;
+  Parse::ToLower(subCommand);
+
+  if (subCommand.empty()) {
+    std::cout << "No bench subcommand provided!" << std::endl;
+    return std::nullopt;
+  }
+
+  if (subCommand == "strategy") {
+    return ParseStrategyBench(command);
+  } else {
+    std::cout << std::format("Unknown subcommand \"{}\"", subCommand)
+              << std::endl;
+    return std::nullopt;
+  }
+}
+
+std::optional<Thunk> BenchCommand::ParseStrategyBench(
+    std::istringstream& command) const {
+  StrategyBenchArgs args;
+
+  const std::optional<std::pair<std::string, StrategyFactory>> strategy =
+      ParseNamedStrategy(command);
+  if (!strategy) return std::nullopt;
+  args.Name = strategy->first;
+  args.Strategy = strategy->second;
+
+  while (true) {
+    std::string arg;
+    command >> arg;
+    Parse::ToLower(arg);
+
+    if (arg.empty()) break;
+
+    if (arg == "--positions" || arg == "-p") {
+      if (!(command >> args.PositionCount)) {
+        std::cerr << "Failed to parse position count!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg == "--games" || arg == "-n") {
+      if (!(command >> args.GameCount) || args.GameCount == 0) {
+        std::cerr << "Failed to parse game count!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg == "--seed") {
+      if (!(command >> args.Seed)) {
+        std::cerr << "Failed to parse seed!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg == "--size" || arg == "-s") {
+      const std::optional<std::pair<size_t, size_t>> dimensions =
+          Parse::ParseDimensions(command);
+      if (!dimensions) return std::nullopt;
+      args.Dimensions = dimensions.value();
+
+      const Parse::GameConfiguration configuration{.Dimensions =
+                                                       args.Dimensions};
+      if (!configuration.IsValid()) {
+        std::cerr << "Invalid board size!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg == "--reference") {
+      args.Reference = ParseNamedStrategy(command);
+      if (!args.Reference) return std::nullopt;
+
+    } else if (arg == "--move-time") {
+      size_t milliseconds;
+      if (!(command >> milliseconds)) {
+        std::cerr << "Failed to parse --move-time milliseconds!" << std::endl;
+        return std::nullopt;
+      }
+      args.MoveTime = std::chrono::milliseconds(milliseconds);
+
+    } else {
+      Parse::Unparse(command, arg);
+      break;
+    }
+  }
+
+  if (!Terminate(command)) return std::nullopt;
+
+  return [args] {
+    PrintStrategyBenchResults(args, ExecuteStrategyBench(args));
+  };
+}
+
+}  // namespace Cli
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../util/parse.h"
+#include "command.h"
+#include "game.h"
+#include "strategies.h"
+
+namespace Cli {
+
+// Benchmark games are cut off after this many plies, as deterministic
+// strategies can repeat the same moves forever
+constexpr size_t BENCH_MAX_PLIES = 200;
+
+// Benchmark positions are reached by playing up to this many random plies from
+// a seeded deal
+constexpr size_t BENCH_POSITION_MAX_PLIES = 20;
+
+struct StrategyBenchArgs {
+  std::string Name;
+  StrategyFactory Strategy;
+
+  // A Random strategy, seeded per game, if not provided
+  std::optional<std::pair<std::string, StrategyFactory>> Reference =
+      std::nullopt;
+
+  size_t PositionCount = 10;
+  size_t GameCount = 10;
+  uint32_t Seed = 0;
+  std::pair<size_t, size_t> Dimensions = {5, 5};
+  std::optional<std::chrono::milliseconds> MoveTime = std::nullopt;
+};
+
+struct StrategyBenchResults {
+  // The time the benchmarked strategy took for each of its moves, in the
+  // positions and the games, sorted
+  std::vector<std::chrono::duration<double>> Latencies;
+  std::chrono::duration<double> ThinkingTime{};
+
+  size_t NodeCount = 0;
+  std::optional<size_t> PeakMemory = std::nullopt;
+
+  // From the point of view of the benchmarked strategy
+  MatchRecord Record;
+
+  size_t GetMoveCount() const { return Latencies.size(); }
+  double GetMovesPerSecond() const;
+  // The latency below which `percentile` percent of the moves fall
+  std::chrono::duration<double> GetLatencyPercentile(
+      const double percentile) const;
+};
+
+StrategyBenchResults ExecuteStrategyBench(const StrategyBenchArgs& args);
+void PrintStrategyBenchResults(const StrategyBenchArgs& args,
+                               const StrategyBenchResults& results);
+
+class BenchCommand : public Command {
+ public:
+  std::optional<Thunk> Parse(std::istringstream& command) const override;
+
+  constexpr std::string GetName() const override { return "bench"; }
+
+  constexpr std::string GetHelpEntry() const override {
+    return Parse::PadCommandName(GetName(),
+                                 "Measures the throughput of a strategy.");
+  }
+
+  constexpr std::string GetHelp() const override {
+    return "bench strategy <strategy> [options]\n"
+           "\n"
+           "Has the strategy move in a fixed, seeded set of positions, and\n"
+           "play a fixed, seeded set of games against a reference strategy,\n"
+           "alternating colours. Reports its moves per second, the latency\n"
+           "percentiles of its moves, the number of positions it searched,\n"
+           "and the peak memory of the process.\n"
+           "\n"
+           "Options:\n"
+           "-p, --positions <count> Move in <count> positions, reached by\n"
+           "                        up to 20 random plies from a seeded\n"
+           "                        deal. Default is 10.\n"
+           "-n, --games <count>     Play <count> games. Default is 10.\n"
+           "--seed <seed>           Seed the positions, the deals and the\n"
+           "                        default reference with <seed>. Default\n"
+           "                        is 0.\n"
+           "-s, --size              Provide the width and height of the\n"
+           "                        board. Default is 5x5.\n"
+           "--reference <strategy>  Play against the provided strategy.\n"
+           "                        Default is a seeded random strategy.\n"
+           "--move-time <ms>        Ask the strategies to decide on each\n"
+           "                        move within <ms> milliseconds.\n";
+  }
+
+ private:
+  std::optional<Thunk> ParseStrategyBench(std::istringstream& command) const;
+};
+
+}  // namespace Cli
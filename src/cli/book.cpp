@@ -0,0 +1,155 @@
+#include "book.h"
+
+#include <format>
+#include <iostream>
+
+#include "../openingBook/openingBook.h"
+#include "../stateGraph/stateGraph.h"
+#include "../util/base64.h"
+
+namespace Cli {
+
+void ExecuteBuildBook(const BuildBookArgs args) {
+  OpeningBook::Builder builder;
+
+  switch (args.Source) {
+    case BookSource::Graph: {
+      const StateGraph::Graph graph =
+          StateGraph::Graph::Load(args.GraphPath).first;
+      builder.AddFromGraph(graph, args.Configuration.ToGame().value(),
+                           args.Plies);
+      break;
+    }
+
+    case BookSource::SelfPlay: {
+      const Parse::GameConfiguration configuration = args.Configuration;
+      builder.AddFromSelfPlay(
+          [configuration] { return configuration.ToGame().value(); },
+          args.Strategy, args.GameCount, args.Plies);
+      break;
+    }
+  }
+
+  const OpeningBook::Book book = builder.Build();
+  if (!book.Save(args.BookPath)) return;
+
+  std::cout << std::format("Saved {} positions to \"{}\"", book.GetSize(),
+                           args.BookPath.string())
+            << std::endl;
+}
+
+void ExecuteProbeBook(const ProbeBookArgs args) {
+  const std::optional<OpeningBook::Book> book =
+      OpeningBook::Book::Load(args.BookPath);
+  if (!book) return;
+
+  const Game::Game game = Game::Game::FromSerialization(args.Serialization);
+  const std::optional<OpeningBook::Entry> entry =
+      book->Find(game.GetPositionKey());
+
+  if (!entry) {
+    std::cout << "Position not in book." << std::endl;
+    return;
+  }
+
+  const Game::Move move = Game::Move::Unpack(entry->Move);
+  std::cout << std::format("Pawn {}, card {}, offset {} (weight {})",
+                           move.PawnId, move.UsedCard.GetName(),
+                           move.OffsetId, entry->Weight)
+            << std::endl;
+}
+
+std::optional<Thunk> BookCommand::Parse(std::istringstream& command) const {
+  if (Parse::ParseHelp(command))
+    return [this] { std::cout << GetHelp() << std::endl; };
+
+  std::string subCommand;
+  command >> subCommand;
+  Parse::ToLower(subCommand);
+
+  if (subCommand.empty()) {
+    std::cout << "No book subcommand provided!" << std::endl;
+    return std::nullopt;
+  }
+
+  if (subCommand == "build") {
+    return ParseBuild(command);
+  } else if (subCommand == "probe") {
+    return ParseProbe(command);
+  } else {
+    std::cout << std::format("Unknown subcommand \"{}\"", subCommand)
+              << std::endl;
+    return std::nullopt;
+  }
+}
+
+std::optional<Thunk> BookCommand::ParseBuild(
+    std::istringstream& command) const {
+  BuildBookArgs args;
+
+  const std::optional<std::filesystem::path> bookPath =
+      Parse::ParsePath(command);
+  if (!bookPath) return std::nullopt;
+  args.BookPath = bookPath.value();
+
+  if (!(command >> args.Plies)) {
+    std::cerr << "Failed to parse opening book plies!" << std::endl;
+    return std::nullopt;
+  }
+
+  std::string source;
+  command >> source;
+  Parse::ToLower(source);
+
+  if (source == "graph") {
+    args.Source = BookSource::Graph;
+
+    const std::optional<std::filesystem::path> graphPath =
+        Parse::ParsePath(command);
+    if (!graphPath) return std::nullopt;
+    args.GraphPath = graphPath.value();
+
+  } else if (source == "selfplay") {
+    args.Source = BookSource::SelfPlay;
+
+    if (!(command >> args.GameCount)) {
+      std::cerr << "Failed to parse self-play game count!" << std::endl;
+      return std::nullopt;
+    }
+
+    const std::optional<StrategyFactory> strategy = ParseStrategy(command);
+    if (!strategy) return std::nullopt;
+    args.Strategy = strategy.value();
+
+  } else {
+    std::cerr << std::format("Unknown opening book source \"{}\"!", source)
+              << std::endl;
+    return std::nullopt;
+  }
+
+  if (!args.Configuration.Parse(command)) return std::nullopt;
+  if (!args.Configuration.IsValid()) return std::nullopt;
+
+  if (!Terminate(command)) return std::nullopt;
+
+  return [args] { ExecuteBuildBook(args); };
+}
+
+std::optional<Thunk> BookCommand::ParseProbe(
+    std::istringstream& command) const {
+  const std::optional<std::filesystem::path> bookPath =
+      Parse::ParsePath(command);
+  if (!bookPath) return std::nullopt;
+
+  const std::optional<Game::GameSerialization> serialization =
+      Game::Game::ParseSerialization(command);
+  if (!serialization) return std::nullopt;
+
+  if (!Terminate(command)) return std::nullopt;
+
+  const ProbeBookArgs args{.BookPath = bookPath.value(),
+                           .Serialization = serialization.value()};
+  return [args] { ExecuteProbeBook(args); };
+}
+
+}  // namespace Cli
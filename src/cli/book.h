@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../util/parse.h"
+#include "command.h"
+#include "strategies.h"
+
+namespace Cli {
+
+enum class BookSource {
+  Graph,
+  SelfPlay,
+};
+
+struct BuildBookArgs {
+  std::filesystem::path BookPath;
+  size_t Plies = 0;
+
+  BookSource Source = BookSource::SelfPlay;
+
+  std::filesystem::path GraphPath;
+
+  size_t GameCount = 0;
+  StrategyFactory Strategy;
+
+  Parse::GameConfiguration Configuration;
+};
+
+struct ProbeBookArgs {
+  std::filesystem::path BookPath;
+  Game::GameSerialization Serialization;
+};
+
+void ExecuteBuildBook(const BuildBookArgs args);
+void ExecuteProbeBook(const ProbeBookArgs args);
+
+class BookCommand : public Command {
+ public:
+  std::optional<Thunk> Parse(std::istringstream& command) const override;
+
+  constexpr std::string GetName() const override { return "book"; }
+
+  constexpr std::string GetHelpEntry() const override {
+    return Parse::PadCommandName(GetName(),
+                                 "Builds or probes an opening book.");
+  }
+
+  constexpr std::string GetHelp() const override {
+    return "book build <book-path> <plies> graph <graph-path> [game_options]\n"
+           "book build <book-path> <plies> selfplay <games> <strategy>\n"
+           "   [game_options]\n"
+           "book probe <book-path> <state_id>\n"
+           "\n"
+           "Builds an opening book covering the first <plies> plies of the\n"
+           "game, or looks up the book move for the given game state.\n"
+           "\n"
+           "Game options are the same as for the \"game\" command, and\n"
+           "define the initial state(s) the book is built from.\n"
+           "\n"
+           "Sources:\n"
+           "graph <graph-path>      Take the optimal moves from a solved\n"
+           "                        state graph, as saved by the\n"
+           "                        `--intermediate` option of\n"
+           "                        `experiment stategraph`. Explores all\n"
+           "                        replies up to <plies> deep.\n"
+           "selfplay <games> <strategy>\n"
+           "                        Play <games> games of the strategy\n"
+           "                        against itself, and store the most\n"
+           "                        played move for each position.\n";
+  }
+
+ private:
+  std::optional<Thunk> ParseBuild(std::istringstream& command) const;
+  std::optional<Thunk> ParseProbe(std::istringstream& command) const;
+};
+
+}  // namespace Cli
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "bench.h"
+#include "book.h"
 #include "cards.h"
 #include "command.h"
 #include "experiment.h"
 #include "game.h"
+#include "positions.h"
 #include "print.h"
+#include "replay.h"
 #include "strategies.h"
+#include "tournament.h"
 #include "version.h"
 
 namespace Cli {
@@ -30,13 +35,18 @@ class Cli : public Command {
   void ExecuteHelp() const;
 
  private:
-  const std::array<const std::unique_ptr<const Command>, 6> Commands = {
+  const std::array<const std::unique_ptr<const Command>, 11> Commands = {
       std::make_unique<CardsCommand>(),
       std::make_unique<GameCommand>(),
       std::make_unique<StrategiesCommand>(),
       std::make_unique<ExperimentCommand>(),
       std::make_unique<PrintCommand>(),
       std::make_unique<VersionCommand>(),
+      std::make_unique<BookCommand>(),
+      std::make_unique<TournamentCommand>(),
+      std::make_unique<ReplayCommand>(),
+      std::make_unique<PositionsCommand>(),
+      std::make_unique<BenchCommand>(),
   };
 };
 
@@ -2,6 +2,7 @@
 
 #include "../experiments/fairCards/fairCards.h"
 #include "../experiments/stateGraph/stateGraph.h"
+#include "../experiments/sweep/sweep.h"
 #include "command.h"
 
 namespace Cli {
@@ -13,7 +14,7 @@ struct ExperimentParser {
   const std::string_view Help;
 };
 
-const inline std::array<ExperimentParser, 2> Experiments = {
+const inline std::array<ExperimentParser, 3> Experiments = {
     ExperimentParser{
         .Name = Experiments::FairCards::Name,
         .Parser = Experiments::FairCards::Parse,
@@ -26,6 +27,12 @@ const inline std::array<ExperimentParser, 2> Experiments = {
         .HelpEntry = Experiments::StateGraph::HelpEntry,
         .Help = Experiments::StateGraph::Help,
     },
+    ExperimentParser{
+        .Name = Experiments::Sweep::Name,
+        .Parser = Experiments::Sweep::Parse,
+        .HelpEntry = Experiments::Sweep::HelpEntry,
+        .Help = Experiments::Sweep::Help,
+    },
 };
 
 void ExecuteListExperiments();
@@ -1,87 +1,165 @@
 #include "game.h"
 
+#include <atomic>
+#include <deque>
 #include <format>
 #include <future>
 #include <iostream>
+#include <random>
 
 #include "../gameMaster.h"
+#include "../strategies/databaseLookup.h"
+#include "../strategies/ponderer.h"
+#include "../util/elo.h"
+#include "../util/stats.h"
+#include "../util/threadPool.h"
+#include "../util/trace.h"
 #include "cards.h"
 
 namespace Cli {
 
-static Color RunGame(const GameArgs args, std::ostream* stream) {
+MatchRecord& MatchRecord::operator+=(const MatchRecord& other) {
+  Wins += other.Wins;
+  Draws += other.Draws;
+  Losses += other.Losses;
+  return *this;
+}
+
+std::optional<Color> RunGame(const GameArgs args, std::ostream* stream) {
   if (!args.IsValid())
     throw std::invalid_argument("Invalid arguments for game!");
 
+  std::unique_ptr<Strategy::Strategy> redStrategy = args.RedStrategy();
+  std::unique_ptr<Strategy::Strategy> blueStrategy = args.BlueStrategy();
+  if (args.DatabasePath) {
+    for (std::unique_ptr<Strategy::Strategy>* strategy :
+         {&redStrategy, &blueStrategy}) {
+      std::optional<PositionDatabase::Database> database =
+          PositionDatabase::Database::Open(args.DatabasePath.value());
+      if (!database)
+        throw std::runtime_error("Failed to open the position database!");
+
+      *strategy = std::make_unique<Strategy::DatabaseLookup>(
+          std::move(*strategy), std::move(database.value()),
+          args.DatabaseMinVisits);
+    }
+  }
+  if (args.Ponder) {
+    redStrategy = std::make_unique<Strategy::Ponderer>(std::move(redStrategy));
+    blueStrategy =
+        std::make_unique<Strategy::Ponderer>(std::move(blueStrategy));
+  }
+
+  const uint32_t seed = args.Seed ? args.Seed.value() : std::random_device()();
+  const Game::Game game = args.Configuration.ToGame(seed).value();
+
   std::unique_ptr<GameMaster> master;
 
-  master =
-      std::make_unique<GameMaster>(args.Configuration.ToGame().value(),
-                                   args.RedStrategy(), args.BlueStrategy());
+  master = std::make_unique<GameMaster>(game, std::move(redStrategy),
+                                        std::move(blueStrategy));
   master->GameMasterPrintType = args.GameArgsPrintType;
+  master->SetOpeningBook(args.Book, args.BookPlies);
+  master->SetTimeControl(args.MoveTime, args.GameTime);
+  master->SetDrawRules(args.MaxPlies, args.Repetitions);
 
   do {
     master->Render(*stream);
     master->Update();
-  } while (!master->IsFinished());
+  } while (!master->IsOver());
   master->Render(*stream);
 
-  return master->IsFinished().value();
+  if (args.Recorder) {
+    GameRecord::Record record{
+        .Dimensions = game.GetDimensions(),
+        .Seed = seed,
+        .Moves = master->GetMoveHistory(),
+        .Winner = master->IsFinished(),
+    };
+    std::ranges::copy(game.GetCards(), record.Cards.begin());
+    args.Recorder->Write(record);
+  }
+
+  return master->IsFinished();
+}
+
+// The arguments for the game with the provided index in a series of games
+static GameArgs ForGame(GameArgs args, const size_t game) {
+  if (args.Seed) args.Seed = args.Seed.value() + game;
+  return args;
+}
+
+static void CountResult(ExecuteGameInfo& info,
+                        const std::optional<Color> winner) {
+  if (!winner) {
+    info.Draws++;
+  } else if (winner == Color::Red) {
+    info.Wins.first++;
+  } else {
+    info.Wins.second++;
+  }
 }
 
 ExecuteGameInfo ExecuteGame(const GameArgs args) {
   ExecuteGameInfo info{};
+  const size_t repeatCount = args.RepeatCount.value_or(1);
   const bool print = args.GameArgsPrintType != PrintType::None;
 
   if (args.Multithread) {
-    std::vector<std::stringstream> streams;
-    std::vector<std::future<Color>> futures;
-    streams.resize(args.RepeatCount);
-    futures.reserve(args.RepeatCount);
+    // Only keep a bounded number of games in flight, so that their buffered
+    // output can be printed in order without holding on to all of it. The
+    // games write to their streams until the pool is joined, so the streams
+    // are declared first, to outlive the pool when an exception unwinds.
+    std::deque<std::pair<std::unique_ptr<std::stringstream>,
+                         std::future<std::optional<Color>>>>
+        inFlight;
+    ThreadPool pool(args.ThreadCount);
+    const size_t maxInFlight = 2 * pool.GetThreadCount();
+
+    size_t submitted = 0;
+    for (size_t game = 0; game < repeatCount; game++) {
+      while (submitted < repeatCount && inFlight.size() < maxInFlight) {
+        std::unique_ptr<std::stringstream> stream =
+            std::make_unique<std::stringstream>();
+        std::stringstream* streamPtr = stream.get();
+        std::future<std::optional<Color>> future =
+            pool.Submit([args = ForGame(args, submitted), streamPtr] {
+              return RunGame(args, streamPtr);
+            });
+        inFlight.emplace_back(std::move(stream), std::move(future));
+        submitted++;
+      }
 
-    for (size_t game = 0; game < args.RepeatCount; game++) {
-      futures.emplace_back(
-          std::async(std::launch::async, RunGame, args, &streams[game]));
-    }
+      auto [stream, future] = std::move(inFlight.front());
+      inFlight.pop_front();
 
-    for (size_t game = 0; game < args.RepeatCount; game++) {
-      if (futures[game].get() == Color::Red) {
-        info.Wins.first++;
-      } else {
-        info.Wins.second++;
-      }
+      CountResult(info, future.get());
 
       if (print) {
-        if (args.RepeatCount > 1) {
-          std::cout << std::format("Game {}/{}:", game + 1, args.RepeatCount)
+        if (repeatCount > 1) {
+          std::cout << std::format("Game {}/{}:", game + 1, repeatCount)
                     << std::endl;
         }
-        std::cout << streams[game].str() << std::endl;
+        std::cout << stream->str() << std::endl;
       }
     }
   } else {
-    for (size_t game = 1; game <= args.RepeatCount; game++) {
-      if (print && args.RepeatCount > 1) {
-        std::cout << std::format("Game {}/{}:", game, args.RepeatCount)
+    for (size_t game = 1; game <= repeatCount; game++) {
+      if (print && repeatCount > 1) {
+        std::cout << std::format("Game {}/{}:", game, repeatCount)
                   << std::endl;
       }
 
-      const Color winner = RunGame(args, &std::cout);
-
-      if (winner == Color::Red) {
-        info.Wins.first++;
-      } else {
-        info.Wins.second++;
-      }
+      CountResult(info, RunGame(ForGame(args, game - 1), &std::cout));
 
       if (print) std::cout << std::endl;
     }
   }
 
   if (args.GameArgsPrintType == PrintType::Wins) {
-    std::cout << std::format("Red won {}/{} games; blue won {}/{} games.",
-                             info.Wins.first, args.RepeatCount,
-                             info.Wins.second, args.RepeatCount)
+    std::cout << std::format("Red won {}/{} games; blue won {}/{} games; "
+                             "{}/{} games were drawn.",
+                             info.Wins.first, repeatCount, info.Wins.second,
+                             repeatCount, info.Draws, repeatCount)
               << std::endl
               << std::endl;
   }
@@ -89,6 +167,111 @@ ExecuteGameInfo ExecuteGame(const GameArgs args) {
   return info;
 }
 
+static void CountResult(MatchRecord& record, const std::optional<Color> winner,
+                        const Color side) {
+  if (!winner) {
+    record.Draws++;
+  } else if (winner == side) {
+    record.Wins++;
+  } else {
+    record.Losses++;
+  }
+}
+
+// Plays a game on each side of the same deal, and returns the results of the
+// red strategy
+static MatchRecord RunGamePair(GameArgs args) {
+  args.Configuration = args.Configuration.WithDrawnCards(args.Seed);
+  args.GameArgsPrintType = PrintType::None;
+
+  std::ostringstream stream;
+  MatchRecord record;
+
+  CountResult(record, RunGame(args, &stream), Color::Red);
+
+  std::swap(args.RedStrategy, args.BlueStrategy);
+  CountResult(record, RunGame(args, &stream), Color::Blue);
+
+  return record;
+}
+
+void ExecuteSprt(const GameArgs args) {
+  const bool print = args.GameArgsPrintType != PrintType::None;
+  const Sprt::Parameters& parameters = args.SprtParameters.value();
+
+  Sprt::Test test(parameters);
+  MatchRecord record;
+
+  // Skip the pairs that are still queued once the test has concluded
+  std::atomic<bool> concluded = false;
+
+  ThreadPool pool(args.ThreadCount);
+  const size_t maxInFlight = 2 * pool.GetThreadCount();
+  std::deque<std::future<std::optional<MatchRecord>>> inFlight;
+
+  const auto canContinue = [&args](const size_t pairCount) {
+    return !args.RepeatCount || pairCount < args.RepeatCount.value();
+  };
+
+  size_t submitted = 0;
+  while (test.GetResult() == Sprt::Result::Continue &&
+         canContinue(test.GetPairCount())) {
+    while (canContinue(submitted) && inFlight.size() < maxInFlight) {
+      inFlight.push_back(pool.Submit(
+          [args = ForGame(args, submitted),
+           &concluded]() -> std::optional<MatchRecord> {
+            if (concluded) return std::nullopt;
+            return RunGamePair(args);
+          }));
+      submitted++;
+    }
+
+    const std::optional<MatchRecord> pair = inFlight.front().get();
+    inFlight.pop_front();
+
+    record += pair.value();
+    test.AddPair(pair->GetHalfPoints());
+
+    if (print) {
+      std::cout << std::format("Pair {}: LLR {:.3f} ({:.3f}, {:.3f})",
+                               test.GetPairCount(),
+                               test.GetLogLikelihoodRatio(),
+                               test.GetLowerBound(), test.GetUpperBound())
+                << std::endl;
+    }
+  }
+  concluded = true;
+
+  const Sprt::Result result = test.GetResult();
+  const std::string conclusion = result == Sprt::Result::AcceptH1
+                                     ? "H1 accepted"
+                                 : result == Sprt::Result::AcceptH0
+                                     ? "H0 accepted"
+                                     : "Inconclusive";
+  const std::array<size_t, 5>& pentanomial = test.GetPentanomial();
+  const Elo::Estimate elo =
+      Elo::FromResults(record.Wins, record.Draws, record.Losses);
+
+  std::cout << std::format("SPRT [{}, {}] (alpha {}, beta {}): {} after {} "
+                           "game pairs.",
+                           parameters.Elo0, parameters.Elo1, parameters.Alpha,
+                           parameters.Beta, conclusion, test.GetPairCount())
+            << std::endl
+            << std::format("LLR {:.3f} ({:.3f}, {:.3f}); pentanomial {} {} "
+                           "{} {} {}.",
+                           test.GetLogLikelihoodRatio(), test.GetLowerBound(),
+                           test.GetUpperBound(), pentanomial[0],
+                           pentanomial[1], pentanomial[2], pentanomial[3],
+                           pentanomial[4])
+            << std::endl
+            << std::format("Red strategy: {}-{}-{}, Elo {:.1f} [{:.1f}, "
+                           "{:.1f}].",
+                           record.Wins, record.Draws, record.Losses,
+                           elo.Difference, elo.Lower, elo.Upper)
+            << std::endl
+            << std::endl;
+}
+
 std::optional<Thunk> GameCommand::Parse(std::istringstream& command) const {
   if (Parse::ParseHelp(command))
     return [this] { std::cout << GetHelp() << std::endl; };
@@ -110,7 +293,36 @@ std::optional<Thunk> GameCommand::Parse(std::istringstream& command) const {
   if (!Terminate(command)) return std::nullopt;
   if (!args.IsValid()) return std::nullopt;
 
-  return [args] { return ExecuteGame(args); };
+  return [args] {
+    GameArgs gameArgs = args;
+    if (gameArgs.RecordPath) {
+      gameArgs.Recorder = GameRecord::Writer::Open(gameArgs.RecordPath.value());
+      if (gameArgs.Recorder == nullptr) return;
+    }
+
+    if (gameArgs.SprtParameters || gameArgs.RepeatCount.value_or(1) > 1)
+      gameArgs.SetBatchDrawRules();
+
+    if (gameArgs.TracePath) Trace::Start();
+    if (gameArgs.Statistics) Stats::Start();
+
+    if (gameArgs.SprtParameters) {
+      ExecuteSprt(gameArgs);
+    } else {
+      ExecuteGame(gameArgs);
+    }
+
+    if (gameArgs.TracePath) Trace::Stop(gameArgs.TracePath.value());
+    if (gameArgs.Statistics) Stats::Stop();
+
+    if (gameArgs.Recorder) {
+      gameArgs.Recorder->Flush();
+      std::cout << std::format("Recorded {} games to \"{}\".",
+                               gameArgs.Recorder->GetRecordCount(),
+                               gameArgs.RecordPath->string())
+                << std::endl;
+    }
+  };
 }
 
 bool GameArgs::Parse(std::istringstream& stream) {
@@ -123,10 +335,21 @@ bool GameArgs::Parse(std::istringstream& stream) {
   if (arg.empty()) return true;
 
   if (arg == "--repeat" || arg == "-n") {
-    if (!(stream >> RepeatCount)) {
+    size_t repeatCount;
+    if (!(stream >> repeatCount)) {
       std::cerr << "Failed to parse repeat count!" << std::endl;
       return false;
     }
+    RepeatCount = repeatCount;
+
+  } else if (arg == "--sprt") {
+    Sprt::Parameters parameters;
+    if (!(stream >> parameters.Elo0 >> parameters.Elo1 >> parameters.Alpha >>
+          parameters.Beta)) {
+      std::cerr << "Failed to parse SPRT parameters!" << std::endl;
+      return false;
+    }
+    SprtParameters = parameters;
 
   } else if (arg == "--print-type" || arg == "-p") {
     std::string printTypeString;
@@ -139,6 +362,81 @@ bool GameArgs::Parse(std::istringstream& stream) {
   } else if (arg == "--multithread" || arg == "-m") {
     Multithread = true;
 
+  } else if (arg == "--threads" || arg == "-t") {
+    if (!(stream >> ThreadCount) || ThreadCount == 0) {
+      std::cerr << "Failed to parse thread count!" << std::endl;
+      return false;
+    }
+    Multithread = true;
+
+  } else if (arg == "--ponder") {
+    Ponder = true;
+
+  } else if (arg == "--move-time" || arg == "--game-time") {
+    size_t milliseconds;
+    if (!(stream >> milliseconds)) {
+      std::cerr << std::format("Failed to parse {} milliseconds!", arg)
+                << std::endl;
+      return false;
+    }
+
+    (arg == "--move-time" ? MoveTime : GameTime) =
+        std::chrono::milliseconds(milliseconds);
+
+  } else if (arg == "--max-plies" || arg == "--repetitions") {
+    size_t count;
+    if (!(stream >> count)) {
+      std::cerr << std::format("Failed to parse {} count!", arg) << std::endl;
+      return false;
+    }
+
+    (arg == "--max-plies" ? MaxPlies : Repetitions) = count;
+
+  } else if (arg == "--database") {
+    DatabasePath = Parse::ParsePath(stream);
+    if (!DatabasePath) return false;
+
+    if (!(stream >> DatabaseMinVisits)) {
+      std::cerr << "Failed to parse minimum database visits!" << std::endl;
+      return false;
+    }
+
+    if (!PositionDatabase::Database::Open(DatabasePath.value())) return false;
+
+  } else if (arg == "--seed") {
+    uint32_t seed;
+    if (!(stream >> seed)) {
+      std::cerr << "Failed to parse seed!" << std::endl;
+      return false;
+    }
+    Seed = seed;
+
+  } else if (arg == "--record") {
+    RecordPath = Parse::ParsePath(stream);
+    if (!RecordPath) return false;
+
+  } else if (arg == "--trace") {
+    TracePath = Parse::ParsePath(stream);
+    if (!TracePath) return false;
+
+  } else if (arg == "--stats") {
+    Statistics = true;
+
+  } else if (arg == "--book") {
+    const std::optional<std::filesystem::path> bookPath =
+        Parse::ParsePath(stream);
+    if (!bookPath) return false;
+
+    if (!(stream >> BookPlies)) {
+      std::cerr << "Failed to parse opening book plies!" << std::endl;
+      return false;
+    }
+
+    std::optional<OpeningBook::Book> book =
+        OpeningBook::Book::Load(bookPath.value());
+    if (!book) return false;
+    Book = std::make_shared<const OpeningBook::Book>(std::move(book.value()));
+
   } else {
     Parse::Unparse(stream, arg);
     return true;
@@ -147,11 +445,41 @@ bool GameArgs::Parse(std::istringstream& stream) {
   return Parse(stream);
 }
 
+void GameArgs::SetBatchDrawRules() {
+  if (!MaxPlies) MaxPlies = BATCH_MAX_PLIES;
+  if (!Repetitions) Repetitions = BATCH_REPETITIONS;
+}
+
 bool GameArgs::IsValid() const {
   if (!Configuration.IsValid()) return false;
 
   if (RedStrategy == nullptr || BlueStrategy == nullptr) return false;
 
+  if (MaxPlies && MaxPlies.value() == 0) {
+    std::cerr << "Maximum plies must be at least 1!" << std::endl;
+    return false;
+  }
+
+  if (Repetitions && Repetitions.value() < 2) {
+    std::cerr << "Repetition count must be at least 2!" << std::endl;
+    return false;
+  }
+
+  if (SprtParameters) {
+    const Sprt::Parameters& parameters = SprtParameters.value();
+    if (parameters.Elo0 >= parameters.Elo1) {
+      std::cerr << "SPRT elo0 must be less than elo1!" << std::endl;
+      return false;
+    }
+
+    if (parameters.Alpha <= 0.0 || 1.0 <= parameters.Alpha ||
+        parameters.Beta <= 0.0 || 1.0 <= parameters.Beta) {
+      std::cerr << "SPRT alpha and beta must lie between 0 and 1!"
+                << std::endl;
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -1,33 +1,83 @@
 #pragma once
 
 #include "../gameMaster.h"
+#include "../gameRecord/gameRecord.h"
+#include "../util/sprt.h"
 #include "../util/parse.h"
 #include "command.h"
 #include "strategies.h"
 
 namespace Cli {
 
+// The draw rules of games played in batches, unless others are provided, so
+// that two strategies repeating the same moves cannot stall the whole batch
+constexpr size_t BATCH_MAX_PLIES = 1000;
+constexpr size_t BATCH_REPETITIONS = 3;
+
 struct GameArgs {
  public:
   bool Parse(std::istringstream& stream);
   bool IsValid() const;
 
+  // Fills in the batch draw rules wherever none were provided
+  void SetBatchDrawRules();
+
   StrategyFactory RedStrategy;
   StrategyFactory BlueStrategy;
 
   Parse::GameConfiguration Configuration;
 
-  size_t RepeatCount = 1;
+  std::optional<size_t> RepeatCount = std::nullopt;
   bool Multithread = false;
+  size_t ThreadCount = 0;
+  bool Ponder = false;
+
+  std::optional<std::chrono::milliseconds> MoveTime = std::nullopt;
+  std::optional<std::chrono::milliseconds> GameTime = std::nullopt;
+
+  std::optional<size_t> MaxPlies = std::nullopt;
+  std::optional<size_t> Repetitions = std::nullopt;
 
   PrintType GameArgsPrintType = PrintType::Board;
+
+  std::optional<Sprt::Parameters> SprtParameters = std::nullopt;
+
+  std::shared_ptr<const OpeningBook::Book> Book = nullptr;
+  size_t BookPlies = 0;
+
+  // The seed random cards are drawn with. Repeated games use consecutive
+  // seeds starting from this one.
+  std::optional<uint32_t> Seed = std::nullopt;
+
+  std::optional<std::filesystem::path> DatabasePath = std::nullopt;
+  size_t DatabaseMinVisits = 1;
+
+  std::optional<std::filesystem::path> RecordPath = std::nullopt;
+  std::shared_ptr<GameRecord::Writer> Recorder = nullptr;
+
+  std::optional<std::filesystem::path> TracePath = std::nullopt;
+  bool Statistics = false;
 };
 
 struct ExecuteGameInfo {
   std::pair<size_t, size_t> Wins;
+  size_t Draws = 0;
+};
+
+// The results of one side of a match
+struct MatchRecord {
+  size_t Wins = 0;
+  size_t Draws = 0;
+  size_t Losses = 0;
+
+  size_t GetHalfPoints() const { return 2 * Wins + Draws; }
+  MatchRecord& operator+=(const MatchRecord& other);
 };
 
+// Returns the winner, or std::nullopt if the game was drawn
+std::optional<Color> RunGame(const GameArgs args, std::ostream* stream);
 ExecuteGameInfo ExecuteGame(const GameArgs args);
+void ExecuteSprt(const GameArgs args);
 
 class GameCommand : public Command {
  public:
@@ -59,6 +109,15 @@ class GameCommand : public Command {
            "                        Default is 5x5.\n"
            "-n, --repeat            Repeat this configuration the provided\n"
            "                        number of times.\n"
+           "--sprt <elo0> <elo1> <alpha> <beta>\n"
+           "                        Play game pairs, with both strategies\n"
+           "                        playing each colour on the same deal,\n"
+           "                        until a sequential probability ratio\n"
+           "                        test decides whether the red strategy\n"
+           "                        is <elo0> (H0) or <elo1> (H1) Elo\n"
+           "                        stronger, with error rates <alpha> and\n"
+           "                        <beta>. With --repeat, stops after at\n"
+           "                        most that many pairs.\n"
            "-p, --print-type        Defines how the game is to be printed.\n"
            "                        - \"board\" prints the game board;\n"
            "                        - \"data\" prints the sequence of moves\n"
@@ -68,9 +127,47 @@ class GameCommand : public Command {
            "                          won by each player;\n"
            "                        - \"none\" doesn't print anything.\n"
            "                        \"board\" is the default.\n"
-           "-m, --multithread       In conjunction with --repeat, plays all\n"
-           "                        games simultaneously on separate\n"
-           "                        threads.\n";
+           "-m, --multithread       In conjunction with --repeat, plays\n"
+           "                        games in parallel, on one thread per\n"
+           "                        hardware thread.\n"
+           "-t, --threads <count>   Like --multithread, but plays games on\n"
+           "                        <count> threads.\n"
+           "--book <book-path> <plies>\n"
+           "                        Play moves from the provided opening\n"
+           "                        book for the first <plies> plies,\n"
+           "                        wherever the book has an entry.\n"
+           "--database <database-path> <min-visits>\n"
+           "                        Let both strategies play the best\n"
+           "                        known move from the provided position\n"
+           "                        database, wherever it was played at\n"
+           "                        least <min-visits> times.\n"
+           "--ponder                Let both strategies think ahead during\n"
+           "                        their opponent's turn.\n"
+           "--move-time <ms>        Stop strategies <ms> milliseconds into\n"
+           "                        each move. A player that does not\n"
+           "                        move in time loses.\n"
+           "--game-time <ms>        Give each player <ms> milliseconds of\n"
+           "                        thinking time for the whole game. A\n"
+           "                        player that runs out of time loses.\n"
+           "--max-plies <plies>     Declare the game drawn once <plies>\n"
+           "                        plies have been played.\n"
+           "--repetitions <count>   Declare the game drawn once the same\n"
+           "                        position has occurred <count> times.\n"
+           "                        Must be at least 2.\n"
+           "                        With --repeat or --sprt, games are\n"
+           "                        drawn after 1000 plies or 3\n"
+           "                        repetitions unless provided otherwise.\n"
+           "--seed <seed>           Draw random cards with the provided\n"
+           "                        seed. Repeated games use consecutive\n"
+           "                        seeds.\n"
+           "--record <record-path>  Store every game in a compact binary\n"
+           "                        game record file, which can be played\n"
+           "                        back with the `replay` command.\n"
+           "--trace <trace-path>    Record the time each strategy takes to\n"
+           "                        decide on its moves, and write it to\n"
+           "                        the provided file as a Chrome trace.\n"
+           "--stats                 Print counters of game copies, moves and\n"
+           "                        state graph lookups as JSON.\n";
   }
 };
 
@@ -0,0 +1,177 @@
+#include "positions.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+
+namespace Cli {
+
+void ExecuteBuildPositions(const BuildPositionsArgs args) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  const std::optional<PositionDatabase::BuildInfo> info =
+      PositionDatabase::Build(args.RecordPaths, args.DatabasePath,
+                              args.ThreadCount, args.RunSize);
+  if (!info) return;
+
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  std::cout << std::format("Saved {} entries from {} games ({} plies) to "
+                           "\"{}\", merging {} runs in {:.3f}s.",
+                           info->EntryCount, info->GameCount, info->PlyCount,
+                           args.DatabasePath.string(), info->RunCount,
+                           seconds)
+            << std::endl;
+
+  if (info->InvalidGameCount > 0) {
+    std::cout << std::format("Skipped {} invalid games.",
+                             info->InvalidGameCount)
+              << std::endl;
+  }
+}
+
+void ExecuteQueryPositions(const QueryPositionsArgs args) {
+  std::optional<PositionDatabase::Database> database =
+      PositionDatabase::Database::Open(args.DatabasePath);
+  if (!database) return;
+
+  const Game::Game game = Game::Game::FromSerialization(args.Serialization);
+  const PositionDatabase::Position position = database->Find(game);
+
+  if (position.Moves.empty()) {
+    std::cout << "Position not in database." << std::endl;
+    return;
+  }
+
+  std::cout << std::format("Visited {} times.", position.GetVisits())
+            << std::endl;
+
+  for (const PositionDatabase::Entry& entry : position.Moves) {
+    const Game::Move move = Game::Move::Unpack(entry.Move);
+    std::cout << std::format("Pawn {}, card {}, offset {}: {}-{}-{} "
+                             "(score {:.3f})",
+                             move.PawnId, move.UsedCard.GetName(),
+                             move.OffsetId, entry.Wins, entry.Draws,
+                             entry.Losses, entry.GetScore())
+              << std::endl;
+  }
+
+  const std::optional<Game::Move> best =
+      position.GetBestMove(args.MinVisits);
+  if (best) {
+    std::cout << std::format("Best known move: pawn {}, card {}, offset {}",
+                             best->PawnId, best->UsedCard.GetName(),
+                             best->OffsetId)
+              << std::endl;
+  } else {
+    std::cout << std::format("No move was played at least {} times.",
+                             args.MinVisits)
+              << std::endl;
+  }
+}
+
+std::optional<Thunk> PositionsCommand::Parse(
+    std::istringstream& command) const {
+  if (Parse::ParseHelp(command))
+    return [this] { std::cout << GetHelp() << std::endl; };
+
+  std::string subCommand;
+  command >> subCommand;
+  Parse::ToLower(subCommand);
+
+  if (subCommand.empty()) {
+    std::cout << "No positions subcommand provided!" << std::endl;
+    return std::nullopt;
+  }
+
+  if (subCommand == "build") {
+    return ParseBuild(command);
+  } else if (subCommand == "query") {
+    return ParseQuery(command);
+  } else {
+    std::cout << std::format("Unknown subcommand \"{}\"", subCommand)
+              << std::endl;
+    return std::nullopt;
+  }
+}
+
+std::optional<Thunk> PositionsCommand::ParseBuild(
+    std::istringstream& command) const {
+  BuildPositionsArgs args;
+
+  const std::optional<std::filesystem::path> databasePath =
+      Parse::ParsePath(command);
+  if (!databasePath) return std::nullopt;
+  args.DatabasePath = databasePath.value();
+
+  while (true) {
+    std::string arg;
+    command >> arg;
+
+    if (arg.empty()) break;
+
+    if (arg == "--threads" || arg == "-t") {
+      if (!(command >> args.ThreadCount) || args.ThreadCount == 0) {
+        std::cerr << "Failed to parse thread count!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg == "--run-size") {
+      if (!(command >> args.RunSize) || args.RunSize == 0) {
+        std::cerr << "Failed to parse run size!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg.starts_with('-')) {
+      Parse::Unparse(command, arg);
+      break;
+
+    } else {
+      args.RecordPaths.emplace_back(arg);
+    }
+  }
+
+  if (!Terminate(command)) return std::nullopt;
+
+  if (args.RecordPaths.empty()) {
+    std::cerr << "No game record files provided!" << std::endl;
+    return std::nullopt;
+  }
+
+  return [args] { ExecuteBuildPositions(args); };
+}
+
+std::optional<Thunk> PositionsCommand::ParseQuery(
+    std::istringstream& command) const {
+  QueryPositionsArgs args;
+
+  const std::optional<std::filesystem::path> databasePath =
+      Parse::ParsePath(command);
+  if (!databasePath) return std::nullopt;
+  args.DatabasePath = databasePath.value();
+
+  const std::optional<Game::GameSerialization> serialization =
+      Game::Game::ParseSerialization(command);
+  if (!serialization) return std::nullopt;
+  args.Serialization = serialization.value();
+
+  std::string arg;
+  command >> arg;
+  if (arg == "--min-visits") {
+    if (!(command >> args.MinVisits)) {
+      std::cerr << "Failed to parse minimum visits!" << std::endl;
+      return std::nullopt;
+    }
+  } else {
+    Parse::Unparse(command, arg);
+  }
+
+  if (!Terminate(command)) return std::nullopt;
+
+  return [args] { ExecuteQueryPositions(args); };
+}
+
+}  // namespace Cli
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include "../game/game.h"
+#include "../positionDatabase/positionDatabase.h"
+#include "../util/parse.h"
+#include "command.h"
+
+namespace Cli {
+
+struct BuildPositionsArgs {
+  std::filesystem::path DatabasePath;
+  std::vector<std::filesystem::path> RecordPaths;
+
+  size_t ThreadCount = 0;
+  size_t RunSize = PositionDatabase::DEFAULT_RUN_SIZE;
+};
+
+struct QueryPositionsArgs {
+  std::filesystem::path DatabasePath;
+  Game::GameSerialization Serialization;
+  size_t MinVisits = 1;
+};
+
+void ExecuteBuildPositions(const BuildPositionsArgs args);
+void ExecuteQueryPositions(const QueryPositionsArgs args);
+
+class PositionsCommand : public Command {
+ public:
+  std::optional<Thunk> Parse(std::istringstream& command) const override;
+
+  constexpr std::string GetName() const override { return "positions"; }
+
+  constexpr std::string GetHelpEntry() const override {
+    return Parse::PadCommandName(GetName(),
+                                 "Builds or queries a position database.");
+  }
+
+  constexpr std::string GetHelp() const override {
+    return "positions build <database-path> <record-path>... [options]\n"
+           "positions query <database-path> <state_id> [options]\n"
+           "\n"
+           "Builds a position database from game record files, as written\n"
+           "by the `--record` option of the `game` command, or prints the\n"
+           "statistics of each move played from the given game state.\n"
+           "\n"
+           "The database holds the wins, draws and losses of every move\n"
+           "played from every recorded position, from the point of view of\n"
+           "the player that made the move.\n"
+           "\n"
+           "Build options:\n"
+           "-t, --threads <count>   Sort runs on <count> threads. Default\n"
+           "                        is one per hardware thread.\n"
+           "--run-size <entries>    Sort the positions in runs of\n"
+           "                        <entries> before merging them, which\n"
+           "                        bounds the memory used.\n"
+           "\n"
+           "Query options:\n"
+           "--min-visits <count>    Only consider moves played at least\n"
+           "                        <count> times for the best move.\n";
+  }
+
+ private:
+  std::optional<Thunk> ParseBuild(std::istringstream& command) const;
+  std::optional<Thunk> ParseQuery(std::istringstream& command) const;
+};
+
+}  // namespace Cli
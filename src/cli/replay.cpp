@@ -0,0 +1,187 @@
+#include "replay.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+
+#include "../gameRecord/gameRecord.h"
+
+namespace Cli {
+
+static void PrintPly(const Game::Game& game, const size_t ply,
+                     const std::optional<Game::Move> move,
+                     const PrintType printType) {
+  switch (printType) {
+    case PrintType::Board:
+      std::cout << std::format("Round {}:", ply + 1) << '\n' << game;
+      break;
+
+    case PrintType::Data:
+      if (move) {
+        std::cout << std::format("{},{},{},", move->PawnId,
+                                 move->UsedCard.GetName(), move->OffsetId)
+                  << '\n';
+      } else {
+        for (Game::Card card : game.GetCards()) {
+          std::cout << std::format("{},", card.GetName());
+        }
+        std::cout << '\n';
+      }
+      break;
+
+    case PrintType::Wins:
+    case PrintType::None:
+    default:
+      break;
+  }
+}
+
+// Plays back a record, and returns an error message if it is inconsistent
+static std::optional<std::string> Replay(const GameRecord::Record& record,
+                                         const PrintType printType) {
+  const Parse::GameConfiguration configuration{.Dimensions =
+                                                   record.Dimensions};
+  if (!configuration.IsValid()) return "invalid board size";
+
+  Game::Game game = record.GetInitialGame();
+  PrintPly(game, 0, std::nullopt, printType);
+
+  for (size_t ply = 0; ply < record.Moves.size(); ply++) {
+    const Game::Move move = record.Moves[ply];
+    if (game.IsFinished() || !game.IsValidMove(move)) {
+      return std::format("invalid move in ply {}", ply + 1);
+    }
+
+    game.DoMove(move);
+    PrintPly(game, ply + 1, move, printType);
+  }
+
+  // The recorded winner can differ from the board if a player ran out of
+  // time, but a finished board must agree with it
+  const std::optional<Color> winner = game.IsFinished();
+  if (winner && winner != record.Winner) return "winner does not match";
+
+  if (printType == PrintType::Wins) {
+    if (record.Winner) {
+      std::cout << "Winner: " << record.Winner.value() << '\n';
+    } else {
+      std::cout << "Draw\n";
+    }
+  }
+
+  return std::nullopt;
+}
+
+void ExecuteReplay(const ReplayArgs args) {
+  std::optional<GameRecord::Reader> reader =
+      GameRecord::Reader::Open(args.RecordPath);
+  if (!reader) return;
+
+  const bool print = args.ReplayPrintType != PrintType::None;
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  size_t gameCount = 0;
+  size_t plyCount = 0;
+  size_t invalidCount = 0;
+  std::array<size_t, 3> outcomes{};  // Red, blue, draw
+
+  for (std::optional<GameRecord::Record> record = reader->Next(); record;
+       record = reader->Next()) {
+    gameCount++;
+    if (args.GameNumber && gameCount != args.GameNumber.value()) continue;
+
+    if (print) {
+      std::cout << std::format("Game {} (seed {}):", gameCount, record->Seed)
+                << '\n';
+    }
+
+    const std::optional<std::string> error =
+        Replay(record.value(), args.ReplayPrintType);
+    if (error) {
+      std::cerr << std::format("Game {} is invalid: {}!", gameCount,
+                               error.value())
+                << std::endl;
+      invalidCount++;
+    } else {
+      plyCount += record->Moves.size();
+      outcomes[record->Winner ? (size_t)record->Winner.value() : 2]++;
+    }
+
+    if (print) std::cout << '\n';
+    if (args.GameNumber) break;
+  }
+
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  const size_t replayedCount = outcomes[0] + outcomes[1] + outcomes[2];
+
+  if (args.GameNumber && gameCount < args.GameNumber.value()) {
+    std::cerr << std::format("The record only holds {} games!", gameCount)
+              << std::endl;
+    return;
+  }
+
+  std::cout << std::format("Played back {} games ({} plies) in {:.3f}s "
+                           "({:.1f} games/s).",
+                           replayedCount, plyCount, seconds,
+                           seconds > 0.0 ? replayedCount / seconds : 0.0)
+            << std::endl
+            << std::format("Red won {}; blue won {}; {} were drawn.",
+                           outcomes[0], outcomes[1], outcomes[2])
+            << std::endl;
+
+  if (invalidCount > 0) {
+    std::cout << std::format("{} games were invalid.", invalidCount)
+              << std::endl;
+  }
+}
+
+std::optional<Thunk> ReplayCommand::Parse(std::istringstream& command) const {
+  if (Parse::ParseHelp(command))
+    return [this] { std::cout << GetHelp() << std::endl; };
+
+  ReplayArgs args;
+
+  const std::optional<std::filesystem::path> recordPath =
+      Parse::ParsePath(command);
+  if (!recordPath) return std::nullopt;
+  args.RecordPath = recordPath.value();
+
+  while (true) {
+    std::string arg;
+    command >> arg;
+    Parse::ToLower(arg);
+
+    if (arg.empty()) break;
+
+    if (arg == "--game" || arg == "-g") {
+      size_t gameNumber;
+      if (!(command >> gameNumber) || gameNumber == 0) {
+        std::cerr << "Failed to parse game number!" << std::endl;
+        return std::nullopt;
+      }
+      args.GameNumber = gameNumber;
+
+    } else if (arg == "--print-type" || arg == "-p") {
+      std::string printTypeString;
+      command >> printTypeString;
+
+      const std::optional<PrintType> printType =
+          ParsePrintType(printTypeString);
+      if (!printType) return std::nullopt;
+      args.ReplayPrintType = printType.value();
+
+    } else {
+      Parse::Unparse(command, arg);
+      break;
+    }
+  }
+
+  if (!Terminate(command)) return std::nullopt;
+
+  return [args] { ExecuteReplay(args); };
+}
+
+}  // namespace Cli
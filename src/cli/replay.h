@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "../gameMaster.h"
+#include "../util/parse.h"
+#include "command.h"
+
+namespace Cli {
+
+struct ReplayArgs {
+  std::filesystem::path RecordPath;
+  PrintType ReplayPrintType = PrintType::None;
+
+  // Counting from 1
+  std::optional<size_t> GameNumber = std::nullopt;
+};
+
+void ExecuteReplay(const ReplayArgs args);
+
+class ReplayCommand : public Command {
+ public:
+  std::optional<Thunk> Parse(std::istringstream& command) const override;
+
+  constexpr std::string GetName() const override { return "replay"; }
+
+  constexpr std::string GetHelpEntry() const override {
+    return Parse::PadCommandName(GetName(),
+                                 "Plays back a game record file.");
+  }
+
+  constexpr std::string GetHelp() const override {
+    return "replay <record-path> [options]\n"
+           "\n"
+           "Plays back the games in a game record file, as written by the\n"
+           "`--record` option of the `game` command. Checks that every\n"
+           "move is valid and that each game ends as recorded, and prints\n"
+           "the outcomes and the throughput.\n"
+           "\n"
+           "Options:\n"
+           "-g, --game <number>     Only play back the game with the\n"
+           "                        provided number, counting from 1.\n"
+           "-p, --print-type        Defines how each game is to be printed,\n"
+           "                        as for the `game` command. \"none\" is\n"
+           "                        the default.\n";
+  }
+};
+
+}  // namespace Cli
@@ -63,6 +63,23 @@ std::optional<StrategyFactory> ParseStrategy(std::istringstream& command) {
   return std::nullopt;
 }
 
+std::optional<std::pair<std::string, StrategyFactory>> ParseNamedStrategy(
+    std::istringstream& command) {
+  const std::string& string = command.str();
+  const std::streampos start = command.tellg();
+
+  const std::optional<StrategyFactory> factory = ParseStrategy(command);
+  if (!factory) return std::nullopt;
+
+  const std::streampos end = command.tellg();
+  std::string name =
+      string.substr(start, end == -1 ? std::string::npos : end - start);
+  name.erase(0, name.find_first_not_of(' '));
+  name.erase(name.find_last_not_of(' ') + 1);
+
+  return std::make_pair(name, factory.value());
+}
+
 std::optional<Thunk> StrategiesCommand::Parse(
     std::istringstream& command) const {
   if (Parse::ParseHelp(command))
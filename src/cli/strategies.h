@@ -12,6 +12,10 @@ void ExecuteStrategies();
 typedef std::function<std::unique_ptr<Strategy::Strategy>()> StrategyFactory;
 std::optional<StrategyFactory> ParseStrategy(std::istringstream& command);
 
+// Parses a strategy, and names it after its specification
+std::optional<std::pair<std::string, StrategyFactory>> ParseNamedStrategy(
+    std::istringstream& command);
+
 struct StrategyParser {
   const std::string Name;
   const std::function<std::optional<StrategyFactory>(std::istringstream&)>
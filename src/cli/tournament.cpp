@@ -0,0 +1,315 @@
+#include "tournament.h"
+
+#include <deque>
+#include <format>
+#include <future>
+#include <iostream>
+
+#include "../util/elo.h"
+#include "../util/threadPool.h"
+#include "game.h"
+
+namespace Cli {
+
+// A pairing of two entrants on a single deal and board size
+struct Matchup {
+  size_t Red;
+  size_t Blue;
+  Parse::GameConfiguration Configuration;
+};
+
+static std::vector<Matchup> ScheduleMatchups(const TournamentArgs& args) {
+  std::vector<std::array<Game::Card, CARD_COUNT>> deals = args.Deals;
+  const size_t randomDealCount =
+      args.Deals.empty() ? std::max<size_t>(args.RandomDealCount, 1)
+                         : args.RandomDealCount;
+  for (size_t deal = 0; deal < randomDealCount; deal++) {
+    const Parse::GameConfiguration configuration{.RepeatCards =
+                                                     args.RepeatCards};
+    deals.push_back(configuration.WithDrawnCards().Cards.value());
+  }
+
+  std::vector<std::pair<size_t, size_t>> sizes = args.Sizes;
+  if (sizes.empty()) sizes.emplace_back(5, 5);
+
+  std::vector<Matchup> matchups;
+  for (const std::array<Game::Card, CARD_COUNT>& cards : deals) {
+    for (const std::pair<size_t, size_t>& size : sizes) {
+      const Parse::GameConfiguration configuration{.Dimensions = size,
+                                                   .Cards = cards};
+
+      for (size_t first = 0; first < args.Entrants.size(); first++) {
+        for (size_t second = first + 1; second < args.Entrants.size();
+             second++) {
+          matchups.push_back(Matchup{first, second, configuration});
+          matchups.push_back(Matchup{second, first, configuration});
+        }
+      }
+    }
+  }
+
+  return matchups;
+}
+
+TournamentResults ExecuteTournament(const TournamentArgs args) {
+  const size_t entrantCount = args.Entrants.size();
+
+  TournamentResults results;
+  results.Records.resize(entrantCount,
+                         std::vector<MatchRecord>(entrantCount));
+
+  const std::vector<Matchup> matchups = ScheduleMatchups(args);
+  const size_t totalGameCount = matchups.size() * args.GameCount;
+
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  ThreadPool pool(args.ThreadCount);
+  const size_t maxInFlight = 2 * pool.GetThreadCount();
+  std::deque<std::pair<const Matchup*, std::future<std::optional<Color>>>>
+      inFlight;
+
+  size_t submitted = 0;
+  for (size_t game = 0; game < totalGameCount; game++) {
+    while (submitted < totalGameCount && inFlight.size() < maxInFlight) {
+      const Matchup& matchup = matchups[submitted / args.GameCount];
+
+      GameArgs gameArgs;
+      gameArgs.RedStrategy = args.Entrants[matchup.Red].Factory;
+      gameArgs.BlueStrategy = args.Entrants[matchup.Blue].Factory;
+      gameArgs.Configuration = matchup.Configuration;
+      gameArgs.GameArgsPrintType = PrintType::None;
+      gameArgs.Ponder = args.Ponder;
+      gameArgs.MoveTime = args.MoveTime;
+      gameArgs.GameTime = args.GameTime;
+      gameArgs.MaxPlies = args.MaxPlies;
+      gameArgs.Repetitions = args.Repetitions;
+      gameArgs.SetBatchDrawRules();
+
+      inFlight.emplace_back(&matchup, pool.Submit([gameArgs] {
+        std::ostringstream stream;
+        return RunGame(gameArgs, &stream);
+      }));
+      submitted++;
+    }
+
+    auto [matchup, future] = std::move(inFlight.front());
+    inFlight.pop_front();
+
+    const std::optional<Color> result = future.get();
+    if (!result) {
+      results.Records[matchup->Red][matchup->Blue].Draws++;
+      results.Records[matchup->Blue][matchup->Red].Draws++;
+      continue;
+    }
+
+    const bool redWon = result == Color::Red;
+    const size_t winner = redWon ? matchup->Red : matchup->Blue;
+    const size_t loser = redWon ? matchup->Blue : matchup->Red;
+    results.Records[winner][loser].Wins++;
+    results.Records[loser][winner].Losses++;
+  }
+
+  results.GameCount = totalGameCount;
+  results.Runtime = std::chrono::steady_clock::now() - start;
+
+  return results;
+}
+
+static void PrintTournamentResults(const TournamentArgs& args,
+                                   const TournamentResults& results) {
+  const size_t entrantCount = args.Entrants.size();
+
+  std::cout << "Entrants:" << std::endl;
+  for (size_t entrant = 0; entrant < entrantCount; entrant++) {
+    std::cout << std::format("{:>3}. {}", entrant + 1,
+                             args.Entrants[entrant].Name)
+              << std::endl;
+  }
+
+  std::cout << std::endl
+            << "Wins-draws-losses of each row against each column:"
+            << std::endl
+            << "    ";
+  for (size_t column = 0; column < entrantCount; column++) {
+    std::cout << std::format("{:>14}", column + 1);
+  }
+  std::cout << std::endl;
+
+  for (size_t row = 0; row < entrantCount; row++) {
+    std::cout << std::format("{:>3}.", row + 1);
+    for (size_t column = 0; column < entrantCount; column++) {
+      const MatchRecord& record = results.Records[row][column];
+      const std::string cell =
+          row == column ? "-"
+                        : std::format("{}-{}-{}", record.Wins, record.Draws,
+                                      record.Losses);
+      std::cout << std::format("{:>14}", cell);
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << std::endl
+            << "Elo relative to the field, with 95% confidence interval:"
+            << std::endl;
+  for (size_t entrant = 0; entrant < entrantCount; entrant++) {
+    MatchRecord total;
+    for (const MatchRecord& record : results.Records[entrant]) {
+      total += record;
+    }
+
+    const Elo::Estimate elo =
+        Elo::FromResults(total.Wins, total.Draws, total.Losses);
+    std::cout << std::format("{:>3}. {:>8.1f} [{:.1f}, {:.1f}] ({}-{}-{})",
+                             entrant + 1, elo.Difference, elo.Lower,
+                             elo.Upper, total.Wins, total.Draws, total.Losses)
+              << std::endl;
+  }
+
+  const double seconds = results.Runtime.count();
+  std::cout << std::endl
+            << std::format("Played {} games in {:.3f}s ({:.1f} games/s).",
+                           results.GameCount, seconds,
+                           seconds > 0.0 ? results.GameCount / seconds : 0.0)
+            << std::endl;
+}
+
+std::optional<TournamentEntrant> TournamentCommand::ParseEntrant(
+    std::istringstream& command) const {
+  const std::optional<std::pair<std::string, StrategyFactory>> strategy =
+      ParseNamedStrategy(command);
+  if (!strategy) return std::nullopt;
+
+  return TournamentEntrant{.Name = strategy->first,
+                           .Factory = strategy->second};
+}
+
+std::optional<Thunk> TournamentCommand::Parse(
+    std::istringstream& command) const {
+  if (Parse::ParseHelp(command))
+    return [this] { std::cout << GetHelp() << std::endl; };
+
+  TournamentArgs args;
+
+  while (true) {
+    std::string next;
+    command >> next;
+    if (next.empty() || next.starts_with('-')) {
+      Parse::Unparse(command, next);
+      break;
+    }
+
+    Parse::Unparse(command, next);
+    const std::optional<TournamentEntrant> entrant = ParseEntrant(command);
+    if (!entrant) return std::nullopt;
+    args.Entrants.push_back(entrant.value());
+  }
+
+  if (!args.Parse(command)) return std::nullopt;
+  if (!Terminate(command)) return std::nullopt;
+  if (!args.IsValid()) return std::nullopt;
+
+  return [args] { PrintTournamentResults(args, ExecuteTournament(args)); };
+}
+
+bool TournamentArgs::Parse(std::istringstream& stream) {
+  std::string arg;
+  stream >> arg;
+  Parse::ToLower(arg);
+
+  if (arg.empty()) return true;
+
+  if (arg == "--cards" || arg == "-c") {
+    const std::optional<std::array<Game::Card, CARD_COUNT>> cards =
+        Parse::ParseCards(stream);
+    if (!cards) return false;
+    Deals.push_back(cards.value());
+
+  } else if (arg == "--random-deals" || arg == "-r") {
+    if (!(stream >> RandomDealCount)) {
+      std::cerr << "Failed to parse random deal count!" << std::endl;
+      return false;
+    }
+
+  } else if (arg == "--duplicate-cards" || arg == "-d") {
+    RepeatCards = true;
+
+  } else if (arg == "--size" || arg == "-s") {
+    const std::optional<std::pair<size_t, size_t>> dimensions =
+        Parse::ParseDimensions(stream);
+    if (!dimensions) return false;
+    Sizes.push_back(dimensions.value());
+
+  } else if (arg == "--repeat" || arg == "-n") {
+    if (!(stream >> GameCount) || GameCount == 0) {
+      std::cerr << "Failed to parse repeat count!" << std::endl;
+      return false;
+    }
+
+  } else if (arg == "--threads" || arg == "-t") {
+    if (!(stream >> ThreadCount) || ThreadCount == 0) {
+      std::cerr << "Failed to parse thread count!" << std::endl;
+      return false;
+    }
+
+  } else if (arg == "--ponder") {
+    Ponder = true;
+
+  } else if (arg == "--move-time" || arg == "--game-time") {
+    size_t milliseconds;
+    if (!(stream >> milliseconds)) {
+      std::cerr << std::format("Failed to parse {} milliseconds!", arg)
+                << std::endl;
+      return false;
+    }
+
+    (arg == "--move-time" ? MoveTime : GameTime) =
+        std::chrono::milliseconds(milliseconds);
+
+  } else if (arg == "--max-plies" || arg == "--repetitions") {
+    size_t count;
+    if (!(stream >> count)) {
+      std::cerr << std::format("Failed to parse {} count!", arg) << std::endl;
+      return false;
+    }
+
+    (arg == "--max-plies" ? MaxPlies : Repetitions) = count;
+
+  } else {
+    Parse::Unparse(stream, arg);
+    return true;
+  }
+
+  return Parse(stream);
+}
+
+bool TournamentArgs::IsValid() const {
+  if (Entrants.size() < 2) {
+    std::cerr << "A tournament needs at least two strategies!" << std::endl;
+    return false;
+  }
+
+  if (MaxPlies && MaxPlies.value() == 0) {
+    std::cerr << "Maximum plies must be at least 1!" << std::endl;
+    return false;
+  }
+
+  if (Repetitions && Repetitions.value() < 2) {
+    std::cerr << "Repetition count must be at least 2!" << std::endl;
+    return false;
+  }
+
+  for (const std::pair<size_t, size_t>& size : Sizes) {
+    const Parse::GameConfiguration configuration{.Dimensions = size};
+    if (!configuration.IsValid()) {
+      std::cerr << std::format("Invalid board size {}x{}!", size.first,
+                               size.second)
+                << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace Cli
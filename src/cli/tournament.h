@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../constants.h"
+#include "../game/card.h"
+#include "../util/parse.h"
+#include "command.h"
+#include "game.h"
+#include "strategies.h"
+
+namespace Cli {
+
+struct TournamentEntrant {
+  std::string Name;
+  StrategyFactory Factory;
+};
+
+struct TournamentArgs {
+ public:
+  bool Parse(std::istringstream& stream);
+  bool IsValid() const;
+
+  std::vector<TournamentEntrant> Entrants;
+
+  std::vector<std::array<Game::Card, CARD_COUNT>> Deals;
+  size_t RandomDealCount = 0;
+  bool RepeatCards = false;
+
+  std::vector<std::pair<size_t, size_t>> Sizes;
+
+  // Per pairing, deal, board size and colour assignment
+  size_t GameCount = 1;
+  size_t ThreadCount = 0;
+
+  bool Ponder = false;
+  std::optional<std::chrono::milliseconds> MoveTime = std::nullopt;
+  std::optional<std::chrono::milliseconds> GameTime = std::nullopt;
+
+  std::optional<size_t> MaxPlies = std::nullopt;
+  std::optional<size_t> Repetitions = std::nullopt;
+};
+
+struct TournamentResults {
+  // Records[i][j] holds the results of entrant i against entrant j
+  std::vector<std::vector<MatchRecord>> Records;
+
+  size_t GameCount = 0;
+  std::chrono::duration<double> Runtime;
+};
+
+TournamentResults ExecuteTournament(const TournamentArgs args);
+
+class TournamentCommand : public Command {
+ public:
+  std::optional<Thunk> Parse(std::istringstream& command) const override;
+
+  constexpr std::string GetName() const override { return "tournament"; }
+
+  constexpr std::string GetHelpEntry() const override {
+    return Parse::PadCommandName(
+        GetName(), "Plays a round-robin tournament between strategies.");
+  }
+
+  constexpr std::string GetHelp() const override {
+    return "tournament <strategy> <strategy> [<strategy>...] [options]\n"
+           "\n"
+           "Plays every pair of strategies against each other, on every\n"
+           "deal and board size, with each strategy playing both colours.\n"
+           "Prints the results of each pairing, an Elo rating relative to\n"
+           "the field with a 95% confidence interval, and the throughput.\n"
+           "\n"
+           "Options:\n"
+           "-c, --cards             Add a deal of five cards, in the order\n"
+           "                        of set-aside, red hand, blue hand. Can\n"
+           "                        be given multiple times.\n"
+           "-r, --random-deals <count>\n"
+           "                        Add <count> randomly drawn deals.\n"
+           "                        Default is a single random deal if no\n"
+           "                        cards are provided.\n"
+           "-d, --duplicate-cards   Allow for duplicate cards to be drawn\n"
+           "                        in random deals.\n"
+           "-s, --size              Add a board size, given as its width\n"
+           "                        and height. Can be given multiple\n"
+           "                        times. Default is 5x5.\n"
+           "-n, --repeat            Play each pairing the provided number\n"
+           "                        of times per deal, size and colour.\n"
+           "-t, --threads <count>   Play games on <count> threads. Default\n"
+           "                        is one per hardware thread.\n"
+           "--ponder                Let strategies think ahead during their\n"
+           "                        opponent's turn.\n"
+           "--move-time <ms>        Stop strategies <ms> milliseconds into\n"
+           "                        each move. A player that does not\n"
+           "                        move in time loses.\n"
+           "--game-time <ms>        Give each player <ms> milliseconds of\n"
+           "                        thinking time per game. A player that\n"
+           "                        runs out of time loses.\n"
+           "--max-plies <plies>     Declare a game drawn once <plies>\n"
+           "                        plies have been played.\n"
+           "--repetitions <count>   Declare a game drawn once the same\n"
+           "                        position has occurred <count> times.\n"
+           "                        Games are drawn after 1000 plies or 3\n"
+           "                        repetitions unless provided otherwise.\n";
+  }
+
+ private:
+  std::optional<TournamentEntrant> ParseEntrant(
+      std::istringstream& command) const;
+};
+
+}  // namespace Cli
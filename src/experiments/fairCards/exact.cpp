@@ -0,0 +1,369 @@
+#include "exact.h"
+
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+#include "../../stateGraph/strategies.h"
+#include "../../util/threadPool.h"
+#include "fairCards.h"
+
+namespace Experiments {
+namespace FairCards {
+namespace Exact {
+
+static constexpr uint32_t Magic = 0x58464E4F;  // "ONFX"
+static constexpr uint32_t Version = 1;
+
+static constexpr size_t HeaderSize = 4 * sizeof(uint32_t);
+static constexpr size_t RecordSize = sizeof(uint16_t) + sizeof(uint64_t);
+
+// The average number of moves from a position, for estimating the memory the
+// edges of a graph take up
+static constexpr size_t EstimatedEdgesPerVertex = 10;
+
+template <typename T>
+static void Write(std::ostream& stream, const T value) {
+  stream.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static T Read(std::istream& stream) {
+  T value;
+  stream.read((char*)&value, sizeof(T));
+  return value;
+}
+
+// All outcomes of a card combination, two bits per distribution
+typedef uint64_t Outcomes;
+
+static Outcome GetOutcome(const Outcomes outcomes, const size_t distribution) {
+  return Outcome((outcomes >> (2 * distribution)) & 0b11);
+}
+
+static void SetOutcome(Outcomes& outcomes, const size_t distribution,
+                       const Outcome outcome) {
+  outcomes |= (Outcomes)outcome << (2 * distribution);
+}
+
+// Whether all distributions were solved, rather than stopped by the memory
+// limit
+static bool IsComplete(const Outcomes outcomes) {
+  for (size_t distribution = 0; distribution < DistributionCount;
+       distribution++) {
+    if (GetOutcome(outcomes, distribution) == Outcome::Unknown) return false;
+  }
+
+  return true;
+}
+
+// The largest number of vertices that a graph fits in `bytes` with, as
+// estimated by Graph::EstimateMemoryUsage
+static size_t GetMaxVertexCount(const size_t bytes) {
+  // Each vertex takes up more than its own size, so `high` never fits
+  size_t low = 0;
+  size_t high = bytes / sizeof(StateGraph::Vertex) + 1;
+  while (low + 1 < high) {
+    const size_t middle = low + (high - low) / 2;
+    const size_t estimate =
+        StateGraph::Graph::EstimateMemoryUsage(
+            middle, middle * EstimatedEdgesPerVertex)
+            .GetTotal();
+    (estimate <= bytes ? low : high) = middle;
+  }
+
+  return low;
+}
+
+static char ToChar(const Outcome outcome) {
+  switch (outcome) {
+    case Outcome::RedWins:
+      return 'R';
+    case Outcome::BlueWins:
+      return 'B';
+    case Outcome::Draw:
+      return 'D';
+    case Outcome::Unknown:
+    default:
+      return '?';
+  }
+}
+
+// The set-aside card, followed by the red and blue hands
+static std::array<std::array<Game::Card, CARD_COUNT>, DistributionCount>
+GetDistributions(const std::array<Game::Card, CARD_COUNT>& cards) {
+  std::array<std::array<Game::Card, CARD_COUNT>, DistributionCount>
+      distributions;
+
+  size_t distribution = 0;
+  for (size_t setAside = 0; setAside < CARD_COUNT; setAside++) {
+    std::array<Game::Card, CARD_COUNT - 1> remaining;
+    for (size_t card = 0, index = 0; card < CARD_COUNT; card++) {
+      if (card != setAside) remaining[index++] = cards[card];
+    }
+
+    for (size_t first = 0; first < remaining.size(); first++) {
+      for (size_t second = first + 1; second < remaining.size(); second++) {
+        std::array<Game::Card, CARD_COUNT>& result =
+            distributions[distribution++];
+        result[0] = cards[setAside];
+        result[1] = remaining[first];
+        result[2] = remaining[second];
+
+        size_t blue = 3;
+        for (size_t card = 0; card < remaining.size(); card++) {
+          if (card != first && card != second) result[blue++] = remaining[card];
+        }
+      }
+    }
+  }
+
+  return distributions;
+}
+
+// Solves all distributions of a combination in a single state graph, as they
+// can all reach each other's positions
+static Outcomes Solve(const std::array<Game::Card, CARD_COUNT>& cards,
+                      const std::pair<size_t, size_t> dimensions,
+                      const std::optional<size_t> maxVertexCount) {
+  StateGraph::Graph graph;
+  const std::function<bool()> shouldStop = [&graph, maxVertexCount] {
+    return maxVertexCount && graph.GetNodeCount() > maxVertexCount.value();
+  };
+
+  Outcomes outcomes = 0;
+  const auto distributions = GetDistributions(cards);
+  for (size_t distribution = 0; distribution < DistributionCount;
+       distribution++) {
+    const Game::Game root(dimensions.first, dimensions.second,
+                          distributions[distribution]);
+
+    StateGraph::Strategies::ForwardRetrogradeAnalysis(graph, root,
+                                                      std::nullopt, shouldStop);
+    if (shouldStop()) continue;  // Leave the outcome unknown
+
+    const std::shared_ptr<const StateGraph::Vertex> vertex =
+        graph.Get(root)->lock();
+    const Color player = root.GetCurrentPlayer();
+
+    Outcome outcome = Outcome::Draw;
+    if (vertex->Quality == WinState::Win) {
+      outcome = player == Color::Red ? Outcome::RedWins : Outcome::BlueWins;
+    } else if (vertex->Quality == WinState::Lose) {
+      outcome = player == Color::Red ? Outcome::BlueWins : Outcome::RedWins;
+    }
+
+    SetOutcome(outcomes, distribution, outcome);
+  }
+
+  return outcomes;
+}
+
+// Reads the outcomes of an earlier, possibly interrupted run, and drops a
+// record that was only partially written. A combination that was solved again
+// takes its last outcomes.
+static std::optional<std::unordered_map<size_t, Outcomes>> ReadResults(
+    const Args& args) {
+  std::unordered_map<size_t, Outcomes> results;
+  if (!std::filesystem::exists(args.OutputPath)) return results;
+
+  std::ifstream stream(args.OutputPath, std::ios::in | std::ios::binary);
+  if (Read<uint32_t>(stream) != Magic || Read<uint32_t>(stream) != Version) {
+    std::cerr << std::format("\"{}\" is not an exact fair cards results file!",
+                             args.OutputPath.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  const uint32_t width = Read<uint32_t>(stream);
+  const uint32_t height = Read<uint32_t>(stream);
+  if (width != args.Dimensions.first || height != args.Dimensions.second) {
+    std::cerr << std::format("\"{}\" contains results for a {}x{} board!",
+                             args.OutputPath.string(), width, height)
+              << std::endl;
+    return std::nullopt;
+  }
+
+  size_t recordCount = 0;
+  while (true) {
+    const uint16_t combination = Read<uint16_t>(stream);
+    const Outcomes outcomes = Read<uint64_t>(stream);
+    if (!stream) break;
+
+    results[combination] = outcomes;
+    recordCount++;
+  }
+  stream.close();
+
+  std::filesystem::resize_file(args.OutputPath,
+                               HeaderSize + recordCount * RecordSize);
+  return results;
+}
+
+static std::string FormatRow(const size_t combination,
+                             const std::array<Game::Card, CARD_COUNT>& cards,
+                             const Outcomes outcomes) {
+  std::string row = std::format("{:04d}, ", combination + 1);
+  for (Game::Card card : cards) row += std::format("{}, ", card.GetName());
+
+  for (size_t distribution = 0; distribution < DistributionCount;
+       distribution++) {
+    row += ToChar(GetOutcome(outcomes, distribution));
+  }
+
+  return row;
+}
+
+void Execute(const Args args) {
+  const std::vector<std::array<Game::Card, CARD_COUNT>> combinations =
+      GetCombinations();
+
+  std::optional<std::unordered_map<size_t, Outcomes>> previous =
+      ReadResults(args);
+  if (!previous) return;
+
+  // Combinations that were stopped by the memory limit are solved again, as
+  // the limit may have been raised since. Only read while the pool runs; its
+  // workers add to `solved` instead.
+  std::erase_if(previous.value(),
+                [](const auto& result) { return !IsComplete(result.second); });
+  const std::unordered_map<size_t, Outcomes> previousResults =
+      std::move(previous.value());
+
+  const bool exists = std::filesystem::exists(args.OutputPath);
+  std::ofstream file(args.OutputPath,
+                     std::ios::out | std::ios::app | std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << std::format("Failed to open \"{}\"!",
+                             args.OutputPath.string())
+              << std::endl;
+    return;
+  }
+
+  if (!exists) {
+    Write<uint32_t>(file, Magic);
+    Write<uint32_t>(file, Version);
+    Write<uint32_t>(file, args.Dimensions.first);
+    Write<uint32_t>(file, args.Dimensions.second);
+    file.flush();
+  }
+
+  std::cout << std::format("Exact fair cards experiment on a {}x{} board, "
+                           "resuming with {}/{} combinations completed:",
+                           args.Dimensions.first, args.Dimensions.second,
+                           previousResults.size(), combinations.size())
+            << std::endl
+            << "co. num, crd1, crd2, crd3, crd4, crd5, outcomes" << std::endl;
+
+  const size_t workerCount =
+      args.ThreadCount == 0
+          ? std::max(std::thread::hardware_concurrency(), 1u)
+          : args.ThreadCount;
+
+  // Split the memory limit between the graphs that are solved simultaneously
+  std::optional<size_t> maxVertexCount = std::nullopt;
+  if (args.MemoryLimit) {
+    maxVertexCount = GetMaxVertexCount(args.MemoryLimit.value() / workerCount);
+  }
+
+  std::unordered_map<size_t, Outcomes> solved;  // Guarded by outputMutex
+  std::mutex outputMutex;
+  {
+    ThreadPool pool(workerCount);
+
+    for (size_t combination = 0; combination < combinations.size();
+         combination++) {
+      if (previousResults.contains(combination)) continue;
+
+      pool.Submit([&, combination] {
+        const Outcomes outcomes = Solve(combinations[combination],
+                                        args.Dimensions, maxVertexCount);
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        Write<uint16_t>(file, combination);
+        Write<uint64_t>(file, outcomes);
+        file.flush();
+
+        solved[combination] = outcomes;
+        std::cout << FormatRow(combination, combinations[combination],
+                               outcomes)
+                  << std::endl;
+      });
+    }
+  }
+
+  // Summarise all results, including those of earlier runs
+  std::array<size_t, 4> totals{};
+  const auto tally = [&totals](const auto& results) {
+    for (const auto& [combination, outcomes] : results) {
+      for (size_t distribution = 0; distribution < DistributionCount;
+           distribution++) {
+        totals[(size_t)GetOutcome(outcomes, distribution)]++;
+      }
+    }
+  };
+  tally(previousResults);
+  tally(solved);
+
+  std::cout << std::format("Red wins {}, blue wins {}, draws {}, unknown {}.",
+                           totals[(size_t)Outcome::RedWins],
+                           totals[(size_t)Outcome::BlueWins],
+                           totals[(size_t)Outcome::Draw],
+                           totals[(size_t)Outcome::Unknown])
+            << std::endl;
+}
+
+std::optional<Cli::Thunk> Parse(std::istringstream& command) {
+  Args args;
+
+  const std::optional<std::filesystem::path> outputPath =
+      Parse::ParsePath(command);
+  if (!outputPath) return std::nullopt;
+  args.OutputPath = outputPath.value();
+
+  while (true) {
+    std::string arg;
+    command >> arg;
+    Parse::ToLower(arg);
+
+    if (arg == "--size" || arg == "-s") {
+      const std::optional<std::pair<size_t, size_t>> dimensions =
+          Parse::ParseDimensions(command);
+      if (!dimensions) return std::nullopt;
+      args.Dimensions = dimensions.value();
+
+    } else if (arg == "--threads" || arg == "-t") {
+      if (!(command >> args.ThreadCount) || args.ThreadCount == 0) {
+        std::cout << "Failed to parse thread count!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else if (arg == "--memory-limit") {
+      size_t megabytes;
+      if (!(command >> megabytes)) {
+        std::cout << "Failed to parse memory limit!" << std::endl;
+        return std::nullopt;
+      }
+      args.MemoryLimit = megabytes * 1024 * 1024;
+
+    } else {
+      Parse::Unparse(command, arg);
+      break;
+    }
+  }
+
+  const Parse::GameConfiguration configuration{.Dimensions = args.Dimensions};
+  if (!configuration.IsValid()) {
+    std::cout << "Invalid board size!" << std::endl;
+    return std::nullopt;
+  }
+
+  return [args] { Execute(args); };
+}
+
+}  // namespace Exact
+}  // namespace FairCards
+}  // namespace Experiments
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+#include "../../cli/command.h"
+
+namespace Experiments {
+namespace FairCards {
+namespace Exact {
+
+// The five cards can be distributed in 5 * (4 choose 2) ways
+constexpr size_t DistributionCount = 30;
+
+// The game-theoretic value of an initial position, in two bits
+enum class Outcome : uint8_t {
+  Unknown,
+  RedWins,
+  BlueWins,
+  Draw,
+};
+
+struct Args {
+  std::pair<size_t, size_t> Dimensions = {5, 5};
+  std::filesystem::path OutputPath;
+  size_t ThreadCount = 0;
+  std::optional<size_t> MemoryLimit = std::nullopt;
+};
+
+void Execute(const Args args);
+
+std::optional<Cli::Thunk> Parse(std::istringstream& command);
+
+}  // namespace Exact
+}  // namespace FairCards
+}  // namespace Experiments
@@ -1,9 +1,16 @@
 #include "fairCards.h"
 
+#include <atomic>
 #include <format>
+#include <fstream>
+#include <mutex>
+#include <semaphore>
+#include <sstream>
+#include <unordered_set>
 
 #include "../../cli/game.h"
-#include "../../strategies/random.h"
+#include "../../util/threadPool.h"
+#include "exact.h"
 
 namespace Experiments {
 namespace FairCards {
@@ -27,52 +34,241 @@ static void AddCombinations(
   }
 }
 
-static std::vector<std::array<Game::Card, CARD_COUNT>> GetCombinations() {
+std::vector<std::array<Game::Card, CARD_COUNT>> GetCombinations() {
   std::vector<std::array<Game::Card, CARD_COUNT>> combinations;
   AddCombinations(combinations, std::array<Game::Card, CARD_COUNT>(), 0);
 
   return std::move(combinations);
 }
 
-void Execute(const size_t repeatCount, const Cli::StrategyFactory strategy) {
+static std::string GetHeader(const size_t repeatCount) {
+  std::string header = std::format(
+      "Fair cards experiment with repeat count {}:\nco. num, co. count, ",
+      repeatCount);
+  for (size_t i = 1; i <= CARD_COUNT; i++) header += std::format("crd{}, ", i);
+  header += "red wins, blue wins, draws";
+
+  return header;
+}
+
+// Reads the combinations that have already been completed in an earlier run.
+// Returns nullopt if the file belongs to a different experiment.
+static std::optional<std::unordered_set<size_t>> ReadCompleted(
+    const std::filesystem::path& path, const size_t repeatCount) {
+  std::unordered_set<size_t> completed;
+
+  std::ifstream file(path);
+  if (!file.is_open()) return completed;
+
+  // A header that was cut off only has to match as far as it goes
+  std::string line;
+  std::istringstream header(GetHeader(repeatCount));
+  std::string headerLine;
+  while (std::getline(header, headerLine) && std::getline(file, line)) {
+    const bool cutOff = file.eof();
+    if (cutOff ? line != headerLine.substr(0, line.size())
+               : line != headerLine) {
+      std::cerr << std::format(
+                       "\"{}\" contains the results of a different "
+                       "experiment!",
+                       path.string())
+                << std::endl;
+      return std::nullopt;
+    }
+  }
+
+  // Only count rows that have been written out in full. A last row without a
+  // line ending was cut off, however many fields it has, and is truncated
+  // before the run resumes.
+  constexpr size_t fieldCount = CARD_COUNT + 5;
+  while (std::getline(file, line)) {
+    if (file.eof()) break;
+    if ((size_t)std::ranges::count(line, ',') != fieldCount - 1) continue;
+    if (line.empty() || !std::isdigit(line[0])) continue;
+
+    completed.insert(std::stoull(line));
+  }
+
+  return completed;
+}
+
+// Drops a row that was only partially written when an earlier run was
+// interrupted
+static void TruncateIncompleteRow(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  const std::string contents((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+  file.close();
+
+  if (contents.empty() || contents.back() == '\n') return;
+
+  const size_t lastLineEnd = contents.rfind('\n');
+  std::filesystem::resize_file(
+      path, lastLineEnd == std::string::npos ? 0 : lastLineEnd + 1);
+}
+
+// The number of header lines that have been written out in full, in a file
+// that has been checked by ReadCompleted and truncated by TruncateIncompleteRow
+static size_t CountHeaderLines(const std::filesystem::path& path,
+                               const size_t repeatCount) {
+  std::ifstream file(path);
+  std::istringstream header(GetHeader(repeatCount));
+
+  size_t count = 0;
+  std::string line;
+  std::string headerLine;
+  while (std::getline(header, headerLine) && std::getline(file, line)) count++;
+
+  return count;
+}
+
+// Hands a queue slot back once a game is done with it, even if the game throws
+struct SlotGuard {
+  std::counting_semaphore<>& Slots;
+  ~SlotGuard() { Slots.release(); }
+};
+
+// The results of a single card combination, updated by the games played on it
+struct CombinationProgress {
+  std::atomic<size_t> Remaining;
+  std::atomic<size_t> RedWins = 0;
+  std::atomic<size_t> BlueWins = 0;
+  std::atomic<size_t> Draws = 0;
+  // Whether a game threw, in which case the row is left out and the
+  // combination is played again on resume
+  std::atomic<bool> Failed = false;
+};
+
+void Execute(const size_t repeatCount, const Cli::StrategyFactory strategy,
+             const std::optional<std::filesystem::path> outputPath,
+             const size_t threadCount) {
   const std::vector<std::array<Game::Card, CARD_COUNT>> combinations =
       GetCombinations();
 
-  // Print header
-  std::cout << std::format("Fair cards experiment with repeat count {}:",
-                           repeatCount)
-            << std::endl;
-  std::cout << "co. num, co. count, ";
-  for (size_t i = 1; i <= CARD_COUNT; i++)
-    std::cout << std::format("crd{}, ", i);
-  std::cout << "red wins, blue wins" << std::endl;
-
-  size_t combinationNumber = 0;
-  for (std::array<Game::Card, CARD_COUNT> cards : combinations) {
-    std::cout << std::format("{:04d}, {}, ", ++combinationNumber,
-                             combinations.size());
-
-    for (Game::Card card : cards) {
-      std::cout << std::format("{}, ", card.GetName());
+  std::unordered_set<size_t> completed;
+  std::ofstream file;
+  if (outputPath) {
+    const std::optional<std::unordered_set<size_t>> previous =
+        ReadCompleted(outputPath.value(), repeatCount);
+    if (!previous) return;
+    completed = std::move(previous.value());
+
+    // A run may have been interrupted before or while writing the header, so
+    // only the header lines that are missing after truncation are written
+    const bool exists = std::filesystem::exists(outputPath.value());
+    if (exists) TruncateIncompleteRow(outputPath.value());
+    const size_t headerLines =
+        CountHeaderLines(outputPath.value(), repeatCount);
+
+    file.open(outputPath.value(), std::ios::app);
+    if (!file.is_open()) {
+      std::cerr << std::format("Failed to open \"{}\"!", outputPath->string())
+                << std::endl;
+      return;
+    }
+
+    std::istringstream header(GetHeader(repeatCount));
+    std::string headerLine;
+    for (size_t line = 0; std::getline(header, headerLine); line++) {
+      if (line >= headerLines) file << headerLine << std::endl;
+    }
+
+    if (exists) {
+      std::cout << std::format("Resuming with {}/{} combinations completed.",
+                               completed.size(), combinations.size())
+                << std::endl;
+    }
+  } else {
+    std::cout << GetHeader(repeatCount) << std::endl;
+  }
+  std::ostream& output = outputPath ? file : std::cout;
+  std::mutex outputMutex;
+
+  std::vector<CombinationProgress> progress(combinations.size());
+  for (CombinationProgress& combination : progress)
+    combination.Remaining = repeatCount;
+
+  const auto writeRow = [&](const size_t combination) {
+    std::string row = std::format("{:04d}, {}, ", combination + 1,
+                                  combinations.size());
+    for (Game::Card card : combinations[combination]) {
+      row += std::format("{}, ", card.GetName());
     }
+    row += std::format("{}, {}, {}", progress[combination].RedWins.load(),
+                       progress[combination].BlueWins.load(),
+                       progress[combination].Draws.load());
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    output << row << std::endl;
+  };
+
+  // Schedule every game of every combination on a single pool, only keeping a
+  // bounded number of them queued. The semaphore must outlive the pool.
+  const size_t workerCount =
+      threadCount == 0 ? std::max(std::thread::hardware_concurrency(), 1u)
+                       : threadCount;
+  std::counting_semaphore<> slots(2 * workerCount);
+  std::atomic<size_t> failedCount = 0;
+  {
+    ThreadPool pool(workerCount);
+
+    for (size_t combination = 0; combination < combinations.size();
+         combination++) {
+      if (completed.contains(combination + 1)) continue;
 
-    Cli::GameArgs args{
-        .RedStrategy = strategy,
-        .BlueStrategy = strategy,
+      Cli::GameArgs args{
+          .RedStrategy = strategy,
+          .BlueStrategy = strategy,
 
-        .Configuration{
-            .Cards = cards,
-        },
+          .Configuration{
+              .Cards = combinations[combination],
+          },
 
-        .RepeatCount = repeatCount,
-        .Multithread = true,
+          .GameArgsPrintType = PrintType::None,
+      };
+      args.SetBatchDrawRules();
 
-        .GameArgsPrintType = PrintType::None,
-    };
+      for (size_t game = 0; game < repeatCount; game++) {
+        slots.acquire();
+        pool.Submit([args, combination, &progress, &slots, &writeRow,
+                     &outputMutex, &failedCount] {
+          const SlotGuard slot{slots};
+          CombinationProgress& result = progress[combination];
 
-    const Cli::ExecuteGameInfo info = Cli::ExecuteGame(args);
+          try {
+            std::ostringstream stream;
+            const std::optional<Color> winner = Cli::RunGame(args, &stream);
 
-    std::cout << std::format("{}, {}", info.Wins.first, info.Wins.second)
+            if (!winner) {
+              result.Draws++;
+            } else {
+              (winner == Color::Red ? result.RedWins : result.BlueWins)++;
+            }
+          } catch (const std::exception& exception) {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cerr << std::format("A game of combination {} failed: {}",
+                                     combination + 1, exception.what())
+                      << std::endl;
+            result.Failed = true;
+          }
+
+          if (--result.Remaining != 0) return;
+          if (result.Failed) {
+            failedCount++;
+          } else {
+            writeRow(combination);
+          }
+        });
+      }
+    }
+
+    // The pool finishes the remaining games before it is destroyed
+  }
+
+  if (failedCount != 0) {
+    std::cerr << std::format("{} combinations were left out, as some of their "
+                             "games failed.",
+                             failedCount.load())
               << std::endl;
   }
 }
@@ -80,6 +276,12 @@ void Execute(const size_t repeatCount, const Cli::StrategyFactory strategy) {
 std::optional<Cli::Thunk> Parse(std::istringstream& command) {
   if (Parse::ParseHelp(command)) return [] { std::cout << Help << std::endl; };
 
+  std::string mode;
+  command >> mode;
+  Parse::ToLower(mode);
+  if (mode == "exact") return Exact::Parse(command);
+  Parse::Unparse(command, mode);
+
   size_t repeatCount;
   if (!(command >> repeatCount)) {
     std::cout << "Did not provide valid repeat count for fair cards experiment!"
@@ -97,7 +299,32 @@ std::optional<Cli::Thunk> Parse(std::istringstream& command) {
       Cli::ParseStrategy(command);
   if (!strategy) return std::nullopt;
 
-  return [repeatCount, strategy] { return Execute(repeatCount, *strategy); };
+  std::optional<std::filesystem::path> outputPath = std::nullopt;
+  size_t threadCount = 0;
+  while (true) {
+    std::string arg;
+    command >> arg;
+    Parse::ToLower(arg);
+
+    if (arg == "--output" || arg == "-o") {
+      outputPath = Parse::ParsePath(command);
+      if (!outputPath) return std::nullopt;
+
+    } else if (arg == "--threads" || arg == "-t") {
+      if (!(command >> threadCount) || threadCount == 0) {
+        std::cout << "Failed to parse thread count!" << std::endl;
+        return std::nullopt;
+      }
+
+    } else {
+      Parse::Unparse(command, arg);
+      break;
+    }
+  }
+
+  return [repeatCount, strategy, outputPath, threadCount] {
+    return Execute(repeatCount, *strategy, outputPath, threadCount);
+  };
 }
 
 }  // namespace FairCards
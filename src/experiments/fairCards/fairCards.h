@@ -1,7 +1,12 @@
 #pragma once
 
+#include <filesystem>
+#include <optional>
+
 #include "../../cli/command.h"
 #include "../../cli/strategies.h"
+#include "../../constants.h"
+#include "../../game/card.h"
 
 namespace Experiments {
 namespace FairCards {
@@ -12,13 +17,43 @@ constexpr inline std::string_view HelpEntry =
     "experiment faircards   Tests whether all card combinations are fair.\n";
 
 constexpr inline std::string_view Help =
-    "experiment faircards <repeat-count> <strategy>\n"
+    "experiment faircards <repeat-count> <strategy> [options]\n"
+    "experiment faircards exact <output-path> [exact_options]\n"
     "\n"
     "Tests whether all card combinations are fair.\n"
     "<repeat-count> specifies how often each combination needs to be\n"
-    "repeated.\n";
-
-void Execute(const size_t repeatCount, const Cli::StrategyFactory strategy);
+    "repeated. Rows are printed in csv format as combinations complete,\n"
+    "which is not necessarily in order. Games are drawn after 1000 plies\n"
+    "or once a position occurs 3 times.\n"
+    "\n"
+    "Options:\n"
+    "-o, --output <path>     Write the results to the provided file\n"
+    "                        instead. If the file already exists, only\n"
+    "                        the combinations missing from it are\n"
+    "                        played.\n"
+    "-t, --threads <count>   Play games on <count> threads. Default is\n"
+    "                        one per hardware thread.\n"
+    "\n"
+    "The exact mode instead solves the initial position of all 30 card\n"
+    "distributions of each combination, which share a single state graph.\n"
+    "Outcomes are appended to <output-path> in a compact binary format, and\n"
+    "combinations already in it are skipped. Each outcome is printed as R\n"
+    "(red wins), B (blue wins), D (draw) or ? (exceeded the memory limit).\n"
+    "\n"
+    "Exact options:\n"
+    "-s, --size              Provide the width and height of the board.\n"
+    "                        Default is 5x5.\n"
+    "-t, --threads <count>   Solve <count> combinations at a time.\n"
+    "                        Default is one per hardware thread.\n"
+    "--memory-limit <MiB>    Give up on combinations whose state graphs\n"
+    "                        would take roughly more than their share of\n"
+    "                        <MiB> mebibytes.\n";
+
+std::vector<std::array<Game::Card, CARD_COUNT>> GetCombinations();
+
+void Execute(const size_t repeatCount, const Cli::StrategyFactory strategy,
+             const std::optional<std::filesystem::path> outputPath,
+             const size_t threadCount);
 
 std::optional<Cli::Thunk> Parse(std::istringstream& command);
 
@@ -1,7 +1,14 @@
 #include "args.h"
 
+#include <cmath>
+#include <limits>
+
+#include "../../stateGraph/sizeEstimate.h"
 #include "../../stateGraph/stateGraph.h"
 #include "../../stateGraph/strategies.h"
+#include "../../util/memory.h"
+#include "../../util/progress.h"
+#include "../../util/stats.h"
 
 namespace Experiments {
 namespace StateGraph {
@@ -23,6 +30,8 @@ std::optional<StateGraphType> StateGraphArgs::ParseStateGraphType(
     return StateGraphType::Component;
   } else if (string == "dispersed" || string == "dispersed-frontier") {
     return StateGraphType::DispersedFrontier;
+  } else if (string == "estimate") {
+    return StateGraphType::Estimate;
   }
 
   std::cerr << std::format("Unknown state graph strategy \"{}\"!\n", string)
@@ -31,6 +40,7 @@ std::optional<StateGraphType> StateGraphArgs::ParseStateGraphType(
                "- retrograde-analysis\n"
                "- forward-retrograde-analysis\n"
                "- dispersed-frontier\n"
+               "- estimate\n"
             << std::endl;
   return std::nullopt;
 }
@@ -65,6 +75,11 @@ std::optional<std::shared_ptr<StateGraphArgs>> StateGraphArgs::Parse(
     args = std::make_shared<DispersedFrontierArgs>();
     if (!std::static_pointer_cast<DispersedFrontierArgs>(args)->Parse(stream))
       return std::nullopt;
+
+  } else if (strategy == "estimate") {
+    args = std::make_shared<EstimateArgs>();
+    if (!std::static_pointer_cast<EstimateArgs>(args)->Parse(stream))
+      return std::nullopt;
   }
 
   if (args == nullptr) {
@@ -141,9 +156,46 @@ bool StateGraphArgs::ParseCommonArgs(std::istringstream& stream) {
     LoadPath = Parse::ParsePath(stream);
     if (!LoadPath) return false;
 
+  } else if (parameter == "--trace") {
+    TracePath = Parse::ParsePath(stream);
+    if (!TracePath) return false;
+
+  } else if (parameter == "--progress") {
+    size_t seconds;
+    if (!(stream >> seconds) || seconds == 0) {
+      std::cerr << "Failed to parse progress interval!" << std::endl;
+      return false;
+    }
+    ProgressInterval = std::chrono::seconds(seconds);
+
+  } else if (parameter == "--memory-limit") {
+    size_t mebibytes;
+    if (!(stream >> mebibytes) || mebibytes == 0) {
+      std::cerr << "Failed to parse memory limit!" << std::endl;
+      return false;
+    }
+    MemoryLimit = mebibytes * 1048576;
+
+  } else if (parameter == "--reserve") {
+    size_t vertices;
+    if (!(stream >> vertices)) {
+      std::cerr << "Failed to parse reserved vertex count!" << std::endl;
+      return false;
+    }
+    ReservedVertices = vertices;
+
+  } else if (parameter == "--csr") {
+    UseCsr = true;
+
+  } else if (parameter == "--stats") {
+    Statistics = true;
+
   } else if (parameter == "--disable-symmetries") {
     UseSymmetries = false;
 
+  } else if (parameter == "--huge-pages") {
+    UseHugePages = true;
+
   } else if (parameter == "--data") {
     Data = true;
 
@@ -156,19 +208,95 @@ bool StateGraphArgs::ParseCommonArgs(std::istringstream& stream) {
 }
 
 Graph StateGraphArgs::GetGraph() {
+  Graph graph;
+
   if (LoadPath) {
-    const auto [graph, runtime] = Graph::Load(LoadPath.value());
+    std::chrono::duration<size_t> runtime;
+    std::tie(graph, runtime) = Graph::Load(LoadPath.value());
 
     if (IntermediateParameters)
       IntermediateParameters->RuntimeTimer.Set(runtime, true);
 
-    return graph;
+  } else if (ImportPaths) {
+    graph = Graph::Import(ImportPaths->first, ImportPaths->second);
+  }
+
+  if (ReservedVertices) graph.Reserve(ReservedVertices.value());
+
+  return graph;
+}
+
+bool StateGraphArgs::IsValid() const {
+  if (StartingConfiguration == nullptr) return false;
+
+  if (MemoryLimit && !IntermediateParameters) {
+    std::cerr << "--memory-limit requires --intermediate, to save the final "
+                 "checkpoint to!"
+              << std::endl;
+    return false;
   }
 
-  if (ImportPaths)
-    return Graph::Import(ImportPaths->first, ImportPaths->second);
+  return true;
+}
+
+std::function<bool()> StateGraphArgs::GetShouldStop() {
+  if (!MemoryLimit) return nullptr;
+
+  Budget.emplace(MemoryLimit.value());
+  return [this] { return Budget->Exceeded(); };
+}
+
+static void PrintMemoryUsage(const Graph& graph) {
+  const MemoryUsage usage = graph.GetMemoryUsage(Progress::Current.Frontier);
+  std::cout << std::format(
+                   "Estimated memory: {:.1f} MiB of vertices, {:.1f} MiB of "
+                   "edges, {:.1f} MiB of edge lists, {:.1f} MiB of keys, "
+                   "{:.1f} MiB of frontier",
+                   usage.VertexObjects / 1048576.0,
+                   usage.EdgeObjects / 1048576.0, usage.EdgeLists / 1048576.0,
+                   usage.Keys / 1048576.0, usage.Frontier / 1048576.0)
+            << std::endl;
+
+  // Each vertex takes up its object and its slot in the vertex table, and
+  // each edge its object and its pointer in the edge list of its source
+  const size_t vertexCount = graph.GetNodeCount();
+  const size_t edgeCount = graph.GetEdgeCount();
+  if (vertexCount != 0) {
+    const size_t vertexBytes = usage.VertexObjects + usage.Keys;
+    const size_t edgeBytes = usage.EdgeObjects + usage.EdgeLists;
+    std::cout << std::format("{:.0f} bytes per vertex and {:.0f} bytes per "
+                             "edge",
+                             (double)vertexBytes / vertexCount,
+                             edgeCount == 0 ? 0.0
+                                            : (double)edgeBytes / edgeCount)
+              << std::endl;
+  }
+
+  const std::optional<size_t> peak = Memory::GetPeakResidentMemory();
+  if (!peak) return;
+
+  std::cout << std::format("Peak memory of the process: {:.1f} MiB",
+                           peak.value() / 1048576.0)
+            << std::endl;
+}
+
+void StateGraphArgs::Finish(Graph& graph) {
+  if (StoppedByMemoryLimit()) {
+    std::cout << std::format(
+                     "Stopped as memory use approached the {} MiB limit. "
+                     "Resume with --load \"{}\".",
+                     Budget->GetLimit() / 1048576,
+                     IntermediateParameters->SavePath.string())
+              << std::endl;
+    IntermediateParameters->Save(graph);
+  }
+
+  if (ExportPaths) graph.Export(ExportPaths->first, ExportPaths->second);
+  if (ImagesPath) graph.ExportImages(ImagesPath.value());
+
+  if (!Data) PrintMemoryUsage(graph);
 
-  return Graph();
+  if (Statistics) Stats::Stop(graph.Vertices.GetStats());
 }
 
 bool ComponentArgs::Parse(std::istringstream& stream) {
@@ -187,18 +315,23 @@ void ComponentArgs::Execute() {
   }
 
   StateGraph::UseSymmetries = UseSymmetries;
+  StateGraph::UseHugePages = UseHugePages;
 
   Graph graph = GetGraph();
 
-  const std::chrono::time_point startTime = std::chrono::system_clock::now();
+  const std::chrono::time_point startTime = std::chrono::steady_clock::now();
 
   ExploreComponent(graph, *StartingConfiguration, MaxDepth,
-                   IntermediateParameters);
+                   IntermediateParameters, GetShouldStop());
 
   const size_t runTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                             std::chrono::system_clock::now() - startTime)
+                             std::chrono::steady_clock::now() - startTime)
                              .count();
 
+  Result = {.RunTime = runTime / 1000.0,
+            .VertexCount = graph.GetNodeCount(),
+            .EdgeCount = graph.GetEdgeCount()};
+
   if (!Data) {
     std::cout << std::format("Run time: {:.3f}s\n", runTime / 1000.0f)
               << std::format("Analysed {} nodes and {} edges",
@@ -210,8 +343,7 @@ void ComponentArgs::Execute() {
               << std::endl;
   }
 
-  if (ExportPaths) graph.Export(ExportPaths->first, ExportPaths->second);
-  if (ImagesPath) graph.ExportImages(ImagesPath.value());
+  Finish(graph);
 }
 
 bool RetrogradeAnalysisArgs::Parse(std::istringstream& stream) {
@@ -231,21 +363,32 @@ void RetrogradeAnalysisArgs::Execute() {
   }
 
   StateGraph::UseSymmetries = UseSymmetries;
+  StateGraph::UseHugePages = UseHugePages;
 
   Graph graph = GetGraph();
 
-  const std::chrono::time_point startTime = std::chrono::system_clock::now();
+  const std::chrono::time_point startTime = std::chrono::steady_clock::now();
 
   ExploreComponent(graph, *StartingConfiguration, MaxDepth,
-                   IntermediateParameters);
+                   IntermediateParameters, GetShouldStop());
 
   const std::chrono::time_point finishedExploringTime =
-      std::chrono::system_clock::now();
-
-  RetrogradeAnalyse(graph);
+      std::chrono::steady_clock::now();
+
+  if (StoppedByMemoryLimit()) {
+    // Leave the graph unanalysed, to be resumed
+  } else if (UseCsr) {
+    // The original graph is freed while the compact copy is analysed
+    CsrGraph csr = CsrGraph::FromGraph(graph);
+    graph = Graph();
+    RetrogradeAnalyse(csr);
+    graph = csr.ToGraph();
+  } else {
+    RetrogradeAnalyse(graph);
+  }
 
   const std::chrono::time_point finishedRetrogradeTime =
-      std::chrono::system_clock::now();
+      std::chrono::steady_clock::now();
 
   const size_t exploreTime =
       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -276,6 +419,11 @@ void RetrogradeAnalysisArgs::Execute() {
     }
   }
 
+  Result = {.RunTime = runTime / 1000.0,
+            .VertexCount = graph.GetNodeCount(),
+            .EdgeCount = graph.GetEdgeCount(),
+            .Quality = qualityString};
+
   if (Data) {
     std::cout << std::format("{:.3f},{:.3f},{:.3f},{},{},{}",
                              exploreTime / 1000.0f, retrogradeTime / 1000.0f,
@@ -295,8 +443,7 @@ void RetrogradeAnalysisArgs::Execute() {
               << std::endl;
   }
 
-  if (ExportPaths) graph.Export(ExportPaths->first, ExportPaths->second);
-  if (ImagesPath) graph.ExportImages(ImagesPath.value());
+  Finish(graph);
 }
 
 void ForwardRetrogradeAnalysisArgs::Execute() {
@@ -306,16 +453,17 @@ void ForwardRetrogradeAnalysisArgs::Execute() {
   }
 
   StateGraph::UseSymmetries = UseSymmetries;
+  StateGraph::UseHugePages = UseHugePages;
 
   Graph graph = GetGraph();
 
-  const std::chrono::time_point startTime = std::chrono::system_clock::now();
+  const std::chrono::time_point startTime = std::chrono::steady_clock::now();
 
   ForwardRetrogradeAnalysis(graph, *StartingConfiguration,
-                            IntermediateParameters);
+                            IntermediateParameters, GetShouldStop());
 
   const size_t runTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                             std::chrono::system_clock::now() - startTime)
+                             std::chrono::steady_clock::now() - startTime)
                              .count();
 
   const std::shared_ptr<const Vertex> vertex =
@@ -335,6 +483,11 @@ void ForwardRetrogradeAnalysisArgs::Execute() {
     }
   }
 
+  Result = {.RunTime = runTime / 1000.0,
+            .VertexCount = graph.GetNodeCount(),
+            .EdgeCount = graph.GetEdgeCount(),
+            .Quality = qualityString};
+
   if (Data) {
     std::cout << std::format("{:.3f},{},{},{}", runTime / 1000.0f,
                              graph.GetNodeCount(), graph.GetEdgeCount(),
@@ -349,8 +502,7 @@ void ForwardRetrogradeAnalysisArgs::Execute() {
               << std::endl;
   }
 
-  if (ExportPaths) graph.Export(ExportPaths->first, ExportPaths->second);
-  if (ImagesPath) graph.ExportImages(ImagesPath.value());
+  Finish(graph);
 }
 
 bool DispersedFrontierArgs::Parse(std::istringstream& stream) {
@@ -385,16 +537,17 @@ void DispersedFrontierArgs::Execute() {
   }
 
   StateGraph::UseSymmetries = UseSymmetries;
+  StateGraph::UseHugePages = UseHugePages;
 
   Graph graph = GetGraph();
 
-  const std::chrono::time_point startTime = std::chrono::system_clock::now();
+  const std::chrono::time_point startTime = std::chrono::steady_clock::now();
 
   DispersedFrontier(graph, *StartingConfiguration, Depth, MaxThreadCount,
-                    IntermediateParameters);
+                    IntermediateParameters, GetShouldStop());
 
   const size_t runTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                             std::chrono::system_clock::now() - startTime)
+                             std::chrono::steady_clock::now() - startTime)
                              .count();
 
   const std::shared_ptr<const Vertex> vertex =
@@ -414,6 +567,11 @@ void DispersedFrontierArgs::Execute() {
     }
   }
 
+  Result = {.RunTime = runTime / 1000.0,
+            .VertexCount = graph.GetNodeCount(),
+            .EdgeCount = graph.GetEdgeCount(),
+            .Quality = qualityString};
+
   if (Data) {
     std::cout << std::format("{:.3f},{},{},{}", runTime / 1000.0f,
                              graph.GetNodeCount(), graph.GetEdgeCount(),
@@ -428,8 +586,102 @@ void DispersedFrontierArgs::Execute() {
               << std::endl;
   }
 
-  if (ExportPaths) graph.Export(ExportPaths->first, ExportPaths->second);
-  if (ImagesPath) graph.ExportImages(ImagesPath.value());
+  Finish(graph);
+}
+
+bool EstimateArgs::Parse(std::istringstream& stream) {
+  if (!(stream >> MaxDepth) || MaxDepth == 0) {
+    std::cerr << "Failed to parse the estimate's max depth!" << std::endl;
+    return false;
+  }
+
+  if (!(stream >> ProbeCount) || ProbeCount == 0) {
+    std::cerr << "Failed to parse the estimate's probe count!" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+// Converts an upper bound to a count. Bounds past the largest size_t saturate,
+// as converting them is undefined behaviour.
+static size_t ToCount(const double bound) {
+  constexpr size_t maxCount = std::numeric_limits<size_t>::max();
+  return bound < (double)maxCount ? (size_t)std::ceil(bound) : maxCount;
+}
+
+// No machine holds a graph larger than this, and the memory estimate of such a
+// graph would overflow
+constexpr size_t MAX_SUGGESTED_COUNT = size_t{1} << 48;
+
+void EstimateArgs::Execute() {
+  if (!Data) {
+    std::cout << "Estimating the state graph size of:\n"
+              << *StartingConfiguration << std::endl;
+  }
+
+  const SizeEstimate estimate =
+      EstimateSize(*StartingConfiguration, MaxDepth, ProbeCount);
+
+  // Sized for the upper bound of the estimate, leaving room for the margin
+  // the memory limit stops at. Trees of realistic depths easily outgrow this,
+  // and then nothing is suggested.
+  const size_t vertices = ToCount(estimate.Vertices.GetUpper());
+  const size_t edges = ToCount(estimate.Edges.GetUpper());
+  const bool suggest =
+      vertices <= MAX_SUGGESTED_COUNT && edges <= MAX_SUGGESTED_COUNT;
+  const std::optional<size_t> bytes =
+      suggest ? std::optional(
+                    Graph::EstimateMemoryUsage(vertices, edges).GetTotal())
+              : std::nullopt;
+
+  if (Data) {
+    std::cout << std::format("{:.0f},{:.0f},{:.0f},{:.0f},{}",
+                             estimate.Vertices.Mean, estimate.Vertices.Error,
+                             estimate.Edges.Mean, estimate.Edges.Error,
+                             bytes ? std::to_string(bytes.value()) : "")
+              << std::endl;
+
+  } else {
+    std::cout << "Depth  Positions (95% confidence interval)\n";
+    for (size_t depth = 0; depth < estimate.Depths.size(); depth++) {
+      const Estimate& positions = estimate.Depths[depth];
+      std::cout << std::format("{:<6} {:.0f} ({:.0f} to {:.0f})\n", depth,
+                               positions.Mean, positions.GetLower(),
+                               positions.GetUpper());
+    }
+
+    std::cout << std::format("\nVertices: {:.0f} ({:.0f} to {:.0f})\n",
+                             estimate.Vertices.Mean,
+                             estimate.Vertices.GetLower(),
+                             estimate.Vertices.GetUpper())
+              << std::format("Edges: {:.0f} ({:.0f} to {:.0f})\n",
+                             estimate.Edges.Mean, estimate.Edges.GetLower(),
+                             estimate.Edges.GetUpper())
+              << std::format(
+                     "These count the game tree up to {} moves deep. "
+                     "Transpositions and symmetries merge positions into a "
+                     "single vertex, so they are an upper bound on the state "
+                     "graph within that depth.\n",
+                     MaxDepth);
+
+    if (bytes) {
+      const size_t memoryLimit =
+          std::ceil(bytes.value() / MEMORY_LIMIT_MARGIN / 1048576.0);
+      std::cout << std::format("Memory: at most {:.1f} MiB\n",
+                               bytes.value() / 1048576.0)
+                << std::format(
+                       "Suggested options: --reserve {} --memory-limit {}",
+                       vertices, memoryLimit)
+                << std::endl;
+    } else {
+      std::cout << "The upper bound is too large to suggest --reserve and "
+                   "--memory-limit."
+                << std::endl;
+    }
+  }
+
+  if (Statistics) Stats::Stop();
 }
 
 }  // namespace StateGraph
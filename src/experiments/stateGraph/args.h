@@ -4,6 +4,7 @@
 
 #include "../../cli/command.h"
 #include "../../game/game.h"
+#include "../../stateGraph/memoryBudget.h"
 #include "../../stateGraph/strategies.h"
 
 namespace Experiments {
@@ -16,13 +17,24 @@ enum class StateGraphType {
   RetrogradeAnalysis,
   ForwardRetrogradeAnalysis,
   DispersedFrontier,
+  Estimate,
+};
+
+// The outcome of a construction, as printed with --data
+struct RunResult {
+  // In seconds
+  double RunTime = 0;
+  size_t VertexCount = 0;
+  size_t EdgeCount = 0;
+  // The outcome of the starting configuration, if the strategy solves it
+  std::optional<std::string> Quality = std::nullopt;
 };
 
 struct StateGraphArgs {
  public:
   virtual StateGraphType GetType() const = 0;
 
-  virtual bool IsValid() const { return StartingConfiguration != nullptr; }
+  virtual bool IsValid() const;
 
   static std::optional<std::shared_ptr<StateGraphArgs>> Parse(
       std::istringstream& stream);
@@ -34,6 +46,7 @@ struct StateGraphArgs {
   std::shared_ptr<Game::Game> StartingConfiguration = nullptr;
 
   bool UseSymmetries = true;
+  bool UseHugePages = false;
 
   bool Data = false;
 
@@ -47,9 +60,35 @@ struct StateGraphArgs {
   std::optional<SaveParameters> IntermediateParameters = std::nullopt;
   std::optional<std::filesystem::path> LoadPath = std::nullopt;
 
+  std::optional<std::filesystem::path> TracePath = std::nullopt;
+  std::optional<std::chrono::seconds> ProgressInterval = std::nullopt;
+  bool Statistics = false;
+
+  // In bytes
+  std::optional<size_t> MemoryLimit = std::nullopt;
+  // The vertices to make room for before construction
+  std::optional<size_t> ReservedVertices = std::nullopt;
+  // Whether retrograde analysis runs on a compressed sparse row copy
+  bool UseCsr = false;
+
+  // Set by constructing strategies once they are executed
+  std::optional<RunResult> Result = std::nullopt;
+
  protected:
   bool ParseCommonArgs(std::istringstream& stream);
 
+  // Tells the construction strategy to stop as the memory limit nears
+  std::function<bool()> GetShouldStop();
+  bool StoppedByMemoryLimit() const {
+    return Budget.has_value() && Budget->HasExceeded();
+  }
+
+  // Saves a checkpoint if the construction was stopped, exports the graph and
+  // prints its memory usage and statistics, as requested
+  void Finish(::StateGraph::Graph& graph);
+
+  std::optional<::StateGraph::MemoryBudget> Budget = std::nullopt;
+
   ::StateGraph::Graph GetGraph();
 };
 
@@ -98,5 +137,19 @@ struct DispersedFrontierArgs : public StateGraphArgs {
   size_t MaxThreadCount = 0;
 };
 
+struct EstimateArgs : public StateGraphArgs {
+  StateGraphType GetType() const override { return StateGraphType::Estimate; }
+
+  bool IsValid() const override {
+    return StateGraphArgs::IsValid() && MaxDepth > 0 && ProbeCount > 0;
+  }
+
+  bool Parse(std::istringstream& stream);
+  void Execute() override;
+
+  size_t MaxDepth = 0;
+  size_t ProbeCount = 0;
+};
+
 }  // namespace StateGraph
 }  // namespace Experiments
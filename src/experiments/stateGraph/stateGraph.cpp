@@ -8,6 +8,9 @@
 #include "../../stateGraph/strategies.h"
 #include "../../util/base64.h"
 #include "../../util/parse.h"
+#include "../../util/progress.h"
+#include "../../util/stats.h"
+#include "../../util/trace.h"
 #include "args.h"
 
 namespace Experiments {
@@ -22,7 +25,20 @@ std::optional<Cli::Thunk> Parse(std::istringstream& command) {
   if (!args.has_value()) return std::nullopt;
   if (!args.value()->IsValid()) return std::nullopt;
 
-  return [args] { args.value()->Execute(); };
+  return [args] {
+    if (args.value()->TracePath) Trace::Start();
+    if (args.value()->Statistics) Stats::Start();
+
+    {
+      std::optional<Progress::Reporter> reporter;
+      if (args.value()->ProgressInterval)
+        reporter.emplace(args.value()->ProgressInterval.value());
+
+      args.value()->Execute();
+    }
+
+    if (args.value()->TracePath) Trace::Stop(args.value()->TracePath.value());
+  };
 }
 
 }  // namespace StateGraph
@@ -34,9 +34,32 @@ constexpr inline std::string_view Help =
     "                        Save an intermediate state graph every \n"
     "                        <save-interval> seconds.\n"
     "--load <file-path>      Load an intermediate state graph.\n"
+    "--trace <file-path>     Record how long exploration, retrograde\n"
+    "                        analysis and saving take on each thread,\n"
+    "                        and write it to the provided file as a\n"
+    "                        Chrome trace.\n"
+    "--progress <seconds>    Print the vertices, edges and expansion\n"
+    "                        rate, the frontier size, the labelled and\n"
+    "                        unlabelled vertices, the resident memory\n"
+    "                        and an ETA where possible to stderr every\n"
+    "                        <seconds> seconds.\n"
+    "--memory-limit <MiB>    Stop, saving a final intermediate state\n"
+    "                        graph, before resident memory reaches <MiB>\n"
+    "                        mebibytes. Requires --intermediate.\n"
+    "--csr                   Run retrograde analysis on a compact copy\n"
+    "                        of the graph in compressed sparse row form.\n"
+    "--reserve <vertices>    Make room for <vertices> vertices before\n"
+    "                        constructing the state graph.\n"
+    "--stats                 Print counters of hash and equality calls,\n"
+    "                        game copies, moves, retrograde sweeps and\n"
+    "                        lock waits, and the probe lengths of\n"
+    "                        the graph's vertex table as JSON.\n"
     "--disable-symmetries    Count each game state as distinct, and do not\n"
     "                        apply symmetries to cut down on the amount of\n"
     "                        game states that need to be analysed.\n"
+    "--huge-pages            Ask for the vertices and edges to be stored\n"
+    "                        in transparent huge pages, where the system\n"
+    "                        supports them.\n"
     "--data                  Print the output data in csv format.\n"
     "\n"
     "Construction strategies:\n"
@@ -56,7 +79,16 @@ constexpr inline std::string_view Help =
     "                        Constructs the state graph in parallel,\n"
     "                        exploring up to a depth of <depth> in each\n"
     "                        separate thread. At most <max_thread_count>\n"
-    "                        are active at one time.\n";
+    "                        are active at one time. Threads add their\n"
+    "                        vertices to the graph directly, and claim\n"
+    "                        each one before expanding it, so none is\n"
+    "                        expanded twice.\n"
+    "estimate <max_depth> <probe_count>\n"
+    "                        Estimate the vertices, edges and memory of\n"
+    "                        the state graph up to <max_depth> moves\n"
+    "                        deep, from <probe_count> random probes,\n"
+    "                        without constructing it. Suggests --reserve\n"
+    "                        and --memory-limit options for the real run.\n";
 
 std::optional<Cli::Thunk> Parse(std::istringstream& command);
 
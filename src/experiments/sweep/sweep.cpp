@@ -0,0 +1,380 @@
+#include "sweep.h"
+
+#include <cmath>
+#include <condition_variable>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "../../util/memory.h"
+#include "../../util/parse.h"
+
+namespace Experiments {
+namespace Sweep {
+
+using namespace StateGraph;
+
+constexpr std::chrono::milliseconds MEMORY_SAMPLE_INTERVAL(10);
+
+// Samples the resident memory on a separate thread, as the peak the platform
+// reports also covers the runs before
+class PeakSampler {
+ public:
+  PeakSampler() { Thread = std::thread(&PeakSampler::Run, this); }
+
+  ~PeakSampler() {
+    if (Thread.joinable()) Stop();
+  }
+
+  PeakSampler(const PeakSampler&) = delete;
+  PeakSampler& operator=(const PeakSampler&) = delete;
+
+  // Stops sampling, and returns the highest resident memory seen, in bytes
+  size_t Stop() {
+    {
+      std::lock_guard lock(Mutex);
+      Stopping = true;
+    }
+    Condition.notify_one();
+    Thread.join();
+
+    Sample();
+    return Peak;
+  }
+
+ private:
+  void Run() {
+    std::unique_lock lock(Mutex);
+    do {
+      Sample();
+    } while (!Condition.wait_for(lock, MEMORY_SAMPLE_INTERVAL,
+                                 [this] { return Stopping; }));
+  }
+
+  void Sample() {
+    Peak = std::max(Peak, Memory::GetResidentMemory().value_or(0));
+  }
+
+  size_t Peak = 0;
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  bool Stopping = false;
+
+  std::thread Thread;
+};
+
+// Discards everything written to std::cout while it lives, and restores it even
+// if an exception unwinds past it
+class SilenceOutput {
+ public:
+  SilenceOutput() : Buffer(std::cout.rdbuf(nullptr)) {}
+  ~SilenceOutput() { std::cout.rdbuf(Buffer); }
+
+  SilenceOutput(const SilenceOutput&) = delete;
+  SilenceOutput& operator=(const SilenceOutput&) = delete;
+
+ private:
+  std::streambuf* const Buffer;
+};
+
+struct Summary {
+  double Mean = 0;
+  double Deviation = 0;
+};
+
+static Summary Summarise(const std::vector<double>& samples) {
+  Summary summary;
+  for (const double sample : samples) summary.Mean += sample;
+  summary.Mean /= samples.size();
+
+  if (samples.size() < 2) return summary;
+
+  for (const double sample : samples)
+    summary.Deviation += (sample - summary.Mean) * (sample - summary.Mean);
+  summary.Deviation = std::sqrt(summary.Deviation / (samples.size() - 1));
+
+  return summary;
+}
+
+static std::string_view GetStrategyName(const StateGraphType type) {
+  switch (type) {
+    case StateGraphType::Component:
+      return "component";
+    case StateGraphType::RetrogradeAnalysis:
+      return "retrograde-analysis";
+    case StateGraphType::ForwardRetrogradeAnalysis:
+      return "forward-retrograde-analysis";
+    case StateGraphType::DispersedFrontier:
+      return "dispersed-frontier";
+    default:
+      return "";
+  }
+}
+
+static std::shared_ptr<StateGraphArgs> MakeRunArgs(const SweepArgs& args,
+                                                   const size_t depth,
+                                                   const size_t threadCount) {
+  std::shared_ptr<StateGraphArgs> run;
+  switch (args.Type) {
+    case StateGraphType::Component: {
+      const std::shared_ptr<ComponentArgs> component =
+          std::make_shared<ComponentArgs>();
+      component->MaxDepth = args.MaxDepth;
+      run = component;
+      break;
+    }
+    case StateGraphType::RetrogradeAnalysis: {
+      const std::shared_ptr<RetrogradeAnalysisArgs> retrograde =
+          std::make_shared<RetrogradeAnalysisArgs>();
+      retrograde->MaxDepth = args.MaxDepth;
+      run = retrograde;
+      break;
+    }
+    case StateGraphType::ForwardRetrogradeAnalysis:
+      run = std::make_shared<ForwardRetrogradeAnalysisArgs>();
+      break;
+    case StateGraphType::DispersedFrontier: {
+      const std::shared_ptr<DispersedFrontierArgs> dispersed =
+          std::make_shared<DispersedFrontierArgs>();
+      dispersed->Depth = depth;
+      dispersed->MaxThreadCount = threadCount;
+      run = dispersed;
+      break;
+    }
+    default:
+      return nullptr;
+  }
+
+  run->UseSymmetries = args.UseSymmetries;
+  run->Data = true;
+  return run;
+}
+
+void Execute(const SweepArgs& args) {
+  std::vector<std::array<Game::Card, CARD_COUNT>> deals = args.Deals;
+  const size_t randomDealCount =
+      args.Deals.empty() ? std::max<size_t>(args.RandomDealCount, 1)
+                         : args.RandomDealCount;
+  for (size_t deal = 0; deal < randomDealCount; deal++) {
+    const Parse::GameConfiguration configuration{.RepeatCards =
+                                                     args.RepeatCards};
+    deals.push_back(configuration.WithDrawnCards().Cards.value());
+  }
+
+  std::vector<std::pair<size_t, size_t>> sizes = args.Sizes;
+  if (sizes.empty()) sizes.emplace_back(5, 5);
+
+  // Other strategies take neither, so they run once per deal and size
+  const bool dispersed = args.Type == StateGraphType::DispersedFrontier;
+  std::vector<size_t> threadCounts = args.ThreadCounts;
+  if (threadCounts.empty() || !dispersed) threadCounts = {1};
+  std::vector<size_t> depths = args.Depths;
+  if (depths.empty() || !dispersed) depths = {1};
+
+  std::ofstream file;
+  if (args.OutputPath) {
+    file.open(args.OutputPath.value());
+    if (!file.is_open()) {
+      std::cerr << std::format("Failed to open \"{}\"!",
+                               args.OutputPath->string())
+                << std::endl;
+      return;
+    }
+  }
+  std::ostream& output = args.OutputPath ? file : std::cout;
+
+  output << "strategy,width,height,cards,threads,depth,run,run_time,"
+            "vertices,edges,vertices_per_second,peak_memory_mib,quality"
+         << std::endl;
+
+  for (const std::array<Game::Card, CARD_COUNT>& cards : deals) {
+    std::string cardNames;
+    for (const Game::Card card : cards) {
+      if (!cardNames.empty()) cardNames += " ";
+      cardNames += card.GetName();
+    }
+
+    for (const auto [width, height] : sizes) {
+      for (const size_t depth : depths) {
+        // The vertices per second of the first thread count
+        std::optional<double> baseline = std::nullopt;
+
+        for (const size_t threadCount : threadCounts) {
+          std::vector<double> runTimes;
+          std::vector<double> rates;
+          std::vector<double> peaks;
+
+          for (size_t runIndex = 0; runIndex < args.RunCount; runIndex++) {
+            const std::shared_ptr<StateGraphArgs> run =
+                MakeRunArgs(args, depth, threadCount);
+            run->StartingConfiguration =
+                std::make_shared<Game::Game>(width, height, cards);
+
+            PeakSampler sampler;
+            {
+              // Only the rows of the sweep are printed, not those of each run
+              const SilenceOutput silence;
+              run->Execute();
+            }
+            const size_t peak = sampler.Stop();
+
+            const RunResult& result = run->Result.value();
+            const double rate = result.RunTime == 0
+                                    ? 0
+                                    : result.VertexCount / result.RunTime;
+            runTimes.push_back(result.RunTime);
+            rates.push_back(rate);
+            peaks.push_back(peak / 1048576.0);
+
+            output << std::format(
+                          "{},{},{},{},{},{},{},{:.3f},{},{},{:.0f},{:.1f},{}",
+                          GetStrategyName(args.Type), width, height, cardNames,
+                          dispersed ? std::to_string(threadCount) : "",
+                          dispersed ? std::to_string(depth) : "", runIndex + 1,
+                          result.RunTime, result.VertexCount,
+                          result.EdgeCount, rate, peak / 1048576.0,
+                          result.Quality.value_or(""))
+                   << std::endl;
+          }
+
+          const Summary runTime = Summarise(runTimes);
+          const Summary rate = Summarise(rates);
+          const Summary peak = Summarise(peaks);
+          if (!baseline) baseline = rate.Mean;
+
+          std::string summary = std::format("{}x{} {}", width, height,
+                                            cardNames);
+          if (dispersed) {
+            summary += std::format(", {} threads, depth {}", threadCount,
+                                   depth);
+          }
+          summary += std::format(
+              ": {:.3f}s +- {:.3f}s, {:.0f} +- {:.0f} vertices/s, peak "
+              "{:.1f} +- {:.1f} MiB",
+              runTime.Mean, runTime.Deviation, rate.Mean, rate.Deviation,
+              peak.Mean, peak.Deviation);
+          if (dispersed && baseline.value() > 0) {
+            summary += std::format(", {:.2f}x the rate of {} threads",
+                                   rate.Mean / baseline.value(),
+                                   threadCounts.front());
+          }
+          std::cerr << summary << std::endl;
+        }
+      }
+    }
+  }
+}
+
+bool SweepArgs::Parse(std::istringstream& stream) {
+  std::string arg;
+  stream >> arg;
+  Parse::ToLower(arg);
+
+  if (arg.empty()) return true;
+
+  if (arg == "--cards" || arg == "-c") {
+    const std::optional<std::array<Game::Card, CARD_COUNT>> cards =
+        Parse::ParseCards(stream);
+    if (!cards) return false;
+    Deals.push_back(cards.value());
+
+  } else if (arg == "--random-deals" || arg == "-r") {
+    if (!(stream >> RandomDealCount)) {
+      std::cerr << "Failed to parse random deal count!" << std::endl;
+      return false;
+    }
+
+  } else if (arg == "--duplicate-cards" || arg == "-d") {
+    RepeatCards = true;
+
+  } else if (arg == "--size" || arg == "-s") {
+    const std::optional<std::pair<size_t, size_t>> dimensions =
+        Parse::ParseDimensions(stream);
+    if (!dimensions) return false;
+    Sizes.push_back(dimensions.value());
+
+  } else if (arg == "--threads" || arg == "-t") {
+    size_t threadCount;
+    if (!(stream >> threadCount) || threadCount == 0) {
+      std::cerr << "Failed to parse thread count!" << std::endl;
+      return false;
+    }
+    ThreadCounts.push_back(threadCount);
+
+  } else if (arg == "--depth") {
+    size_t depth;
+    if (!(stream >> depth) || depth == 0) {
+      std::cerr << "Failed to parse dispersed frontier depth!" << std::endl;
+      return false;
+    }
+    Depths.push_back(depth);
+
+  } else if (arg == "--repeat" || arg == "-n") {
+    if (!(stream >> RunCount) || RunCount == 0) {
+      std::cerr << "Failed to parse repeat count!" << std::endl;
+      return false;
+    }
+
+  } else if (arg == "--output" || arg == "-o") {
+    OutputPath = Parse::ParsePath(stream);
+    if (!OutputPath) return false;
+
+  } else if (arg == "--disable-symmetries") {
+    UseSymmetries = false;
+
+  } else {
+    Parse::Unparse(stream, arg);
+    return true;
+  }
+
+  return Parse(stream);
+}
+
+bool SweepArgs::IsValid() const {
+  if (Type == StateGraphType::Estimate) {
+    std::cerr << "Only construction strategies can be swept!" << std::endl;
+    return false;
+  }
+
+  for (const std::pair<size_t, size_t>& size : Sizes) {
+    const Parse::GameConfiguration configuration{.Dimensions = size};
+    if (!configuration.IsValid()) {
+      std::cerr << std::format("Invalid board size {}x{}!", size.first,
+                               size.second)
+                << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::optional<Cli::Thunk> Parse(std::istringstream& command) {
+  if (Parse::ParseHelp(command)) return [] { std::cout << Help << std::endl; };
+
+  SweepArgs args;
+
+  const std::optional<StateGraphType> type =
+      StateGraphArgs::ParseStateGraphType(command);
+  if (!type) return std::nullopt;
+  args.Type = type.value();
+
+  if (args.Type == StateGraphType::Component ||
+      args.Type == StateGraphType::RetrogradeAnalysis) {
+    if (!(command >> args.MaxDepth)) {
+      std::cerr << "Failed to parse max depth!" << std::endl;
+      return std::nullopt;
+    }
+  }
+
+  if (!args.Parse(command)) return std::nullopt;
+  if (!args.IsValid()) return std::nullopt;
+
+  return [args] { Execute(args); };
+}
+
+}  // namespace Sweep
+}  // namespace Experiments
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "../../cli/command.h"
+#include "../../constants.h"
+#include "../../game/card.h"
+#include "../stateGraph/args.h"
+
+namespace Experiments {
+namespace Sweep {
+
+constexpr inline std::string_view Name = "sweep";
+
+constexpr inline std::string_view HelpEntry =
+    "experiment sweep       Times a state graph construction strategy\n"
+    "                       over a grid of configurations.\n";
+
+constexpr inline std::string_view Help =
+    "experiment sweep <construction_strategy> [options]\n"
+    "\n"
+    "Runs the construction strategy on every combination of deal, board\n"
+    "size, thread count and depth, and writes the run time, vertices per\n"
+    "second, peak resident memory and outcome of each run as a csv row.\n"
+    "After the runs of a combination, their mean and standard deviation\n"
+    "are printed to stderr, along with how the vertices per second scale\n"
+    "relative to the first thread count.\n"
+    "\n"
+    "Construction strategies:\n"
+    "component <max_depth>\n"
+    "retrograde-analysis, retrograde <max_depth>\n"
+    "forward-retrograde-analysis, forward-retrograde, forward\n"
+    "dispersed-frontier, dispersed\n"
+    "See `experiment stategraph help`.\n"
+    "\n"
+    "Options:\n"
+    "-c, --cards             Add a deal of five cards, in the order of\n"
+    "                        set-aside, red hand, blue hand. Can be given\n"
+    "                        multiple times.\n"
+    "-r, --random-deals <count>\n"
+    "                        Add <count> randomly drawn deals. Default is\n"
+    "                        a single random deal if no cards are\n"
+    "                        provided.\n"
+    "-d, --duplicate-cards   Allow for duplicate cards to be drawn in\n"
+    "                        random deals.\n"
+    "-s, --size              Add a board size, given as its width and\n"
+    "                        height. Can be given multiple times. Default\n"
+    "                        is 5x5.\n"
+    "-t, --threads <count>   Add a maximum thread count for the\n"
+    "                        dispersed frontier strategy. Can be given\n"
+    "                        multiple times. Default is 1.\n"
+    "--depth <depth>         Add a depth for the dispersed frontier\n"
+    "                        strategy. Can be given multiple times.\n"
+    "                        Default is 1.\n"
+    "-n, --repeat <count>    Run each combination <count> times. Default\n"
+    "                        is 3.\n"
+    "-o, --output <path>     Write the rows to the provided file instead.\n"
+    "--disable-symmetries    Count each game state as distinct.\n";
+
+struct SweepArgs {
+ public:
+  bool Parse(std::istringstream& stream);
+  bool IsValid() const;
+
+  StateGraph::StateGraphType Type = StateGraph::StateGraphType::Component;
+  // Of the component and retrograde analysis strategies
+  size_t MaxDepth = 0;
+
+  std::vector<std::array<Game::Card, CARD_COUNT>> Deals;
+  size_t RandomDealCount = 0;
+  bool RepeatCards = false;
+  std::vector<std::pair<size_t, size_t>> Sizes;
+
+  // Of the dispersed frontier strategy
+  std::vector<size_t> ThreadCounts;
+  std::vector<size_t> Depths;
+
+  size_t RunCount = 3;
+  bool UseSymmetries = true;
+  std::optional<std::filesystem::path> OutputPath = std::nullopt;
+};
+
+void Execute(const SweepArgs& args);
+
+std::optional<Cli::Thunk> Parse(std::istringstream& command);
+
+}  // namespace Sweep
+}  // namespace Experiments
@@ -51,6 +51,13 @@ class Board {
   bool OnBoard(const std::optional<const Coordinate> coordinate) const;
   std::optional<Color> IsFinished() const;
 
+  // The bytes this board has allocated on the heap
+  size_t GetHeapSize() const {
+    return Grid.capacity() * sizeof(Tile) +
+           (RedLocations.capacity() + BlueLocations.capacity()) *
+               sizeof(Coordinate);
+  }
+
   std::ostream& StreamPlayer(std::ostream& stream, const Color player) const;
   std::ostream& StreamPlayerRow(std::ostream& stream, const Color player,
                                 const size_t row, size_t& pawnIndex) const;
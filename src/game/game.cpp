@@ -11,6 +11,7 @@
 
 #include "../util/base64.h"
 #include "../util/parse.h"
+#include "../util/stats.h"
 
 namespace Game {
 
@@ -31,11 +32,16 @@ Game::Game(Board&& board, std::array<Card, CARD_COUNT>&& cards,
 }
 
 Game::Game(const Game& other)
+    : Game(other, Allocations::Scope(Allocations::Subsystem::Game)) {}
+
+Game::Game(const Game& other, const Allocations::Scope&)
     : GameBoard(other.GameBoard),
       Cards(other.Cards),
       CurrentPlayer(other.CurrentPlayer),
       ValidMoves(other.ValidMoves),
-      HasValidMovesVal(other.HasValidMovesVal) {}
+      HasValidMovesVal(other.HasValidMovesVal) {
+  Stats::Count(Stats::Current.GameCopies);
+}
 
 Game::Game(Game&& other)
     : GameBoard(std::move(other.GameBoard)),
@@ -45,11 +51,12 @@ Game::Game(Game&& other)
       HasValidMovesVal(std::move(other.HasValidMovesVal)) {}
 
 Game Game::WithRandomCards(const size_t width, const size_t height,
-                           const bool repeatCards) {
+                           const bool repeatCards,
+                           const std::optional<uint32_t> seed) {
   std::array<Card, CARD_COUNT> cards;
 
   std::random_device randomDevice;
-  std::mt19937 generator(randomDevice());
+  std::mt19937 generator(seed ? seed.value() : randomDevice());
   std::uniform_int_distribution<size_t> randomCard(
       0, (size_t)CardType::CardTypeCount - 1);
 
@@ -63,6 +70,20 @@ Game Game::WithRandomCards(const size_t width, const size_t height,
   return Game(width, height, std::move(cards));
 }
 
+PositionKey PositionKey::FromSerialization(
+    const GameSerialization& serialization) {
+  constexpr uint64_t lowMask = ~uint64_t{0};
+
+  return PositionKey{
+      .High = (serialization >> 64).to_ullong(),
+      .Low = (serialization & GameSerialization(lowMask)).to_ullong(),
+  };
+}
+
+GameSerialization PositionKey::ToSerialization() const {
+  return (GameSerialization(High) << 64) | GameSerialization(Low);
+}
+
 static constexpr size_t ReadBits(GameSerialization& input,
                                  const size_t length) {
   size_t result = 0;
@@ -162,6 +183,7 @@ bool Game::operator==(const Game& other) const {
 }
 
 void Game::SetValidMoves() {
+  const Allocations::Scope scope(Allocations::Subsystem::Game);
   ValidMoves.clear();
 
   // No valid moves for a finished game
@@ -260,6 +282,9 @@ std::optional<std::string> Game::IsInvalidMove(const Move move) const {
 }
 
 void Game::DoMove(const Move move) {
+  const Allocations::Scope scope(Allocations::Subsystem::Game);
+  Stats::Count(Stats::Current.DoMoveCalls);
+
   if (HasValidMoves()) {
     if (!IsValidMove(move)) {
       const std::string message =
@@ -4,6 +4,8 @@
 #include <array>
 #include <bit>
 #include <bitset>
+#include <compare>
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <ostream>
@@ -12,6 +14,7 @@
 #include <unordered_map>
 
 #include "../constants.h"
+#include "../util/allocations.h"
 #include "../util/color.h"
 #include "board.h"
 #include "card.h"
@@ -30,6 +33,20 @@ constexpr size_t GAME_SERIALIZATION_SIZE =
     std::bit_width(MAX_DIMENSION * MAX_DIMENSION) * MAX_DIMENSION * 2;
 typedef std::bitset<GAME_SERIALIZATION_SIZE> GameSerialization;
 
+// A game serialization packed into two words,
+// so that it can be sorted and compared cheaply
+struct PositionKey {
+  static_assert(GAME_SERIALIZATION_SIZE <= 128);
+
+  static PositionKey FromSerialization(const GameSerialization& serialization);
+  GameSerialization ToSerialization() const;
+
+  auto operator<=>(const PositionKey& other) const = default;
+
+  uint64_t High = 0;
+  uint64_t Low = 0;
+};
+
 class Game {
  public:
   Game(const size_t width, const size_t height,
@@ -40,8 +57,11 @@ class Game {
   Game(const Game& other);
   Game(Game&& other);
 
-  static Game WithRandomCards(const size_t width, const size_t height,
-                              const bool repeatCards = false);
+  // Draws the cards from a generator seeded with `seed`, or with a random
+  // seed if none is given
+  static Game WithRandomCards(
+      const size_t width, const size_t height, const bool repeatCards = false,
+      const std::optional<uint32_t> seed = std::nullopt);
   static Game FromSerialization(GameSerialization serialization);
   static std::optional<GameSerialization> ParseSerialization(
       std::istringstream& stream);
@@ -91,11 +111,22 @@ class Game {
   void DoMove(const Move move);
 
   GameSerialization Serialize() const;
+  PositionKey GetPositionKey() const {
+    return PositionKey::FromSerialization(Serialize());
+  }
+
+  // The bytes this game has allocated on the heap
+  size_t GetHeapSize() const {
+    return GameBoard.GetHeapSize() + ValidMoves.capacity() * sizeof(Move);
+  }
 
   bool ExportImage(std::filesystem::path filepath) const;
   friend std::ostream& operator<<(std::ostream& stream, const Game& game);
 
  private:
+  // Attributes the allocations of the copy to the game core
+  Game(const Game& other, const Allocations::Scope& scope);
+
   bool CheckIsValidMove(const Move move) const;
   void SetValidMoves();
 
@@ -123,3 +154,10 @@ template <>
 struct std::hash<Game::Game> {
   size_t operator()(const Game::Game& game) const noexcept;
 };
+
+template <>
+struct std::hash<Game::PositionKey> {
+  size_t operator()(const Game::PositionKey& key) const noexcept {
+    return key.Low ^ (key.High * 0x9E3779B97F4A7C15);
+  }
+};
@@ -1,5 +1,9 @@
 #include "move.h"
 
+#include <bit>
+
+#include "../constants.h"
+
 namespace Game {
 
 bool Move::operator==(const Move& other) const {
@@ -7,4 +11,30 @@ bool Move::operator==(const Move& other) const {
          UsedCard == other.UsedCard;
 }
 
+static constexpr size_t PawnIdSize = std::bit_width(MAX_DIMENSION - 1);
+static constexpr size_t CardSize =
+    std::bit_width((size_t)CardType::CardTypeCount);
+static constexpr size_t OffsetIdSize = 4;
+static_assert(PawnIdSize + CardSize + OffsetIdSize <= 16);
+
+uint16_t Move::Pack() const {
+  size_t packed = PawnId;
+  packed |= (size_t)UsedCard.Type << PawnIdSize;
+  packed |= OffsetId << (PawnIdSize + CardSize);
+
+  return (uint16_t)packed;
+}
+
+Move Move::Unpack(const uint16_t packed) {
+  constexpr size_t pawnIdMask = (1 << PawnIdSize) - 1;
+  constexpr size_t cardMask = (1 << CardSize) - 1;
+  constexpr size_t offsetIdMask = (1 << OffsetIdSize) - 1;
+
+  return Move{
+      .PawnId = packed & pawnIdMask,
+      .UsedCard = Card{(CardType)((packed >> PawnIdSize) & cardMask)},
+      .OffsetId = (packed >> (PawnIdSize + CardSize)) & offsetIdMask,
+  };
+}
+
 }  // namespace Game
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "../util/coordinate.h"
 #include "../util/offset.h"
 #include "card.h"
@@ -12,6 +14,10 @@ struct Move {
   size_t OffsetId = 0;
 
   bool operator==(const Move& move) const;
+
+  // Packs the move into 16 bits, for compact storage on disk
+  uint16_t Pack() const;
+  static Move Unpack(const uint16_t packed);
 };
 
 }  // namespace Game
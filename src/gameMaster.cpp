@@ -1,10 +1,16 @@
 #include "gameMaster.h"
 
+#include <condition_variable>
 #include <format>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
+#include <stop_token>
+#include <thread>
 
+#include "util/allocations.h"
 #include "util/parse.h"
+#include "util/trace.h"
 
 std::optional<PrintType> ParsePrintType(std::string string) {
   Parse::ToLower(string);
@@ -51,17 +57,27 @@ void GameMaster::PrintData(std::ostream& stream) const {
     for (Game::Card card : GameInstance.GetCards()) {
       stream << std::format("{},", card.GetName());
     }
-    stream << std::endl;
+    stream << '\n';
   } else {
-    Game::Move move = MoveHistory.top();
+    Game::Move move = MoveHistory.back();
     stream << std::format("{},{},{},", move.PawnId, move.UsedCard.GetName(),
                           move.OffsetId)
-           << std::endl;
+           << '\n';
   }
 }
 
 void GameMaster::PrintBoard(std::ostream& stream) const {
   stream << std::format("Round {}:", Round) << std::endl << GameInstance;
+
+  if (TimeForfeitWinner) {
+    stream << ~TimeForfeitWinner.value() << " ran out of time." << std::endl;
+  }
+
+  if (Draw == DrawReason::Repetition) {
+    stream << "Draw by repetition." << std::endl;
+  } else if (Draw == DrawReason::MaxPlies) {
+    stream << std::format("Draw after {} plies.", Round - 1) << std::endl;
+  }
 }
 
 void GameMaster::Render(std::ostream& stream) const {
@@ -77,7 +93,11 @@ void GameMaster::Render(std::ostream& stream) const {
     case PrintType::Wins: {
       const std::optional<Color> winner = IsFinished();
       if (winner) {
-        stream << "Winner: " << winner.value() << std::endl;
+        stream << "Winner: " << winner.value();
+        if (TimeForfeitWinner) stream << " (on time)";
+        stream << std::endl;
+      } else if (Draw) {
+        stream << "Draw" << std::endl;
       }
 
       break;
@@ -89,24 +109,161 @@ void GameMaster::Render(std::ostream& stream) const {
   }
 }
 
-void GameMaster::Update() {
+std::optional<Color> GameMaster::IsFinished() const {
+  if (TimeForfeitWinner) return TimeForfeitWinner;
+
+  return GameInstance.IsFinished();
+}
+
+void GameMaster::SetTimeControl(
+    const std::optional<std::chrono::milliseconds> moveTime,
+    const std::optional<std::chrono::milliseconds> gameTime) {
+  MoveTime = moveTime;
+  GameTime = gameTime;
+  RemainingTime.fill(gameTime.value_or(std::chrono::milliseconds::zero()));
+}
+
+void GameMaster::SetDrawRules(const std::optional<size_t> maxPlies,
+                              const std::optional<size_t> repetitions) {
+  MaxPlies = maxPlies;
+  Repetitions = repetitions;
+
+  PositionCounts.clear();
+  Draw = std::nullopt;
+  UpdateDraw();
+}
+
+void GameMaster::UpdateDraw() {
   if (IsFinished()) return;
 
+  if (Repetitions) {
+    const size_t count = ++PositionCounts[GameInstance.GetPositionKey()];
+    if (count >= Repetitions.value()) {
+      Draw = DrawReason::Repetition;
+      return;
+    }
+  }
+
+  if (MaxPlies && Round - 1 >= MaxPlies.value()) Draw = DrawReason::MaxPlies;
+}
+
+Strategy::SearchLimits GameMaster::GetSearchLimits(
+    const std::chrono::steady_clock::time_point start) const {
+  Strategy::SearchLimits limits;
+
+  if (MoveTime) limits.Deadline = start + MoveTime.value();
+
+  // Spread the remaining clock over the moves still to come, so that a single
+  // long search does not use it all up
+  if (GameTime) {
+    const std::chrono::steady_clock::time_point clockDeadline =
+        start + GetRemainingTime(GameInstance.GetCurrentPlayer()) /
+                    CLOCK_MOVES_TO_GO;
+    limits.Deadline = limits.Deadline
+                          ? std::min(limits.Deadline.value(), clockDeadline)
+                          : clockDeadline;
+  }
+
+  return limits;
+}
+
+// Requests a stop from `stopSource` at `deadline`, unless the returned thread
+// is stopped first
+static std::jthread StartTimer(
+    std::stop_source stopSource,
+    const std::chrono::steady_clock::time_point deadline) {
+  return std::jthread(
+      [stopSource, deadline](const std::stop_token timerStop) mutable {
+        std::mutex mutex;
+        std::condition_variable_any condition;
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait_until(lock, timerStop, deadline, [] { return false; });
+
+        if (!timerStop.stop_requested()) stopSource.request_stop();
+      });
+}
+
+std::optional<Game::Move> GameMaster::ProbeBook() const {
+  if (Book == nullptr || Round > BookPlies) return std::nullopt;
+
+  return Book->Probe(GameInstance);
+}
+
+void GameMaster::Update() {
+  if (IsOver()) return;
+
+  const Color player = GameInstance.GetCurrentPlayer();
+
   Game::Move move;
-  switch (GameInstance.GetCurrentPlayer()) {
-    case Color::Red:
-      move = RedPlayer->GetMove(GameInstance);
-      break;
-    case Color::Blue:
-      move = BluePlayer->GetMove(GameInstance);
-      break;
+  const std::optional<Game::Move> bookMove = ProbeBook();
+  if (bookMove) {
+    move = bookMove.value();
+  } else {
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    Strategy::SearchLimits limits = GetSearchLimits(start);
 
-    default:
-      const size_t colorNum = (size_t)GameInstance.GetCurrentPlayer();
-      throw std::runtime_error(std::format("Invalid color {}", colorNum));
+    // Signal the deadline through the stop token as well, for strategies
+    // that only watch the token
+    std::stop_source stopSource;
+    limits.StopToken = stopSource.get_token();
+    std::jthread timer;
+    if (limits.Deadline)
+      timer = StartTimer(stopSource, limits.Deadline.value());
+
+    const Trace::Scope scope("Strategy::GetMove");
+    const Allocations::Scope allocationScope(
+        Allocations::Subsystem::Strategies);
+    switch (player) {
+      case Color::Red:
+        move = RedPlayer->GetMove(GameInstance, limits);
+        break;
+      case Color::Blue:
+        move = BluePlayer->GetMove(GameInstance, limits);
+        break;
+
+      default:
+        const size_t colorNum = (size_t)player;
+        throw std::runtime_error(std::format("Invalid color {}", colorNum));
+    }
+
+    const std::chrono::milliseconds elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+    if (MoveTime && elapsed > MoveTime.value() + MOVE_TIME_GRACE) {
+      TimeForfeitWinner = ~player;
+      return;
+    }
+
+    if (GameTime) {
+      std::chrono::milliseconds& remaining = RemainingTime[(size_t)player];
+      remaining -= elapsed;
+
+      if (remaining < std::chrono::milliseconds::zero()) {
+        TimeForfeitWinner = ~player;
+        return;
+      }
+    }
   }
 
   GameInstance.DoMove(move);
   Round++;
-  MoveHistory.push(move);
+  MoveHistory.push_back(move);
+  UpdateDraw();
+
+  // Let the player that just moved think during the opponent's turn
+  if (!IsOver()) {
+    switch (GameInstance.GetCurrentPlayer()) {
+      case Color::Red:
+        BluePlayer->Ponder(GameInstance);
+        break;
+      case Color::Blue:
+        RedPlayer->Ponder(GameInstance);
+        break;
+
+      default:
+        break;
+    }
+  }
 }
@@ -1,12 +1,21 @@
 #pragma once
 
+#include <chrono>
 #include <iostream>
 #include <memory>
-#include <stack>
+#include <unordered_map>
+#include <vector>
 
 #include "game/game.h"
+#include "openingBook/openingBook.h"
 #include "strategies/strategy.h"
 
+// The number of moves the remaining game time is budgeted for
+constexpr size_t CLOCK_MOVES_TO_GO = 20;
+
+// How long after its move time a strategy may take to notice the deadline
+constexpr std::chrono::milliseconds MOVE_TIME_GRACE{100};
+
 enum class PrintType {
   None,
   Board,
@@ -16,6 +25,11 @@ enum class PrintType {
 
 std::optional<PrintType> ParsePrintType(std::string string);
 
+enum class DrawReason {
+  MaxPlies,
+  Repetition,
+};
+
 class GameMaster {
  public:
   GameMaster(const size_t width, const size_t height,
@@ -31,11 +45,39 @@ class GameMaster {
 
   void Render(std::ostream& stream = std::cout) const;
   void Update();
-  std::optional<Color> IsFinished() const { return GameInstance.IsFinished(); }
+  std::optional<Color> IsFinished() const;
+  std::optional<DrawReason> IsDraw() const { return Draw; }
+  bool IsOver() const { return IsFinished() || IsDraw(); }
 
   size_t GetRound() const { return Round; }
   const Game::Game& GetGame() const { return GameInstance; }
-  const std::stack<Game::Move>& GetMoveHistory() const { return MoveHistory; }
+  const std::vector<Game::Move>& GetMoveHistory() const {
+    return MoveHistory;
+  }
+
+  // Play moves from the book for the first `plies` plies, if available
+  void SetOpeningBook(std::shared_ptr<const OpeningBook::Book> book,
+                      const size_t plies) {
+    Book = std::move(book);
+    BookPlies = plies;
+  }
+
+  // Give each player at most `moveTime` to think per move, and `gameTime` in
+  // total. Strategies are stopped once their time is up; a player that
+  // exceeds its move time by more than MOVE_TIME_GRACE, or its total time,
+  // forfeits the game.
+  void SetTimeControl(const std::optional<std::chrono::milliseconds> moveTime,
+                      const std::optional<std::chrono::milliseconds> gameTime);
+
+  std::chrono::milliseconds GetRemainingTime(const Color player) const {
+    return RemainingTime[(size_t)player];
+  }
+  bool IsTimeForfeit() const { return TimeForfeitWinner.has_value(); }
+
+  // Declare the game drawn once `maxPlies` plies have been played, or once
+  // the same position has occurred `repetitions` times
+  void SetDrawRules(const std::optional<size_t> maxPlies,
+                    const std::optional<size_t> repetitions);
 
   PrintType GameMasterPrintType = PrintType::Board;
 
@@ -46,7 +88,26 @@ class GameMaster {
   std::unique_ptr<Strategy::Strategy> BluePlayer;
 
   size_t Round = 1;
-  std::stack<Game::Move> MoveHistory;
+  std::vector<Game::Move> MoveHistory;
+
+  std::shared_ptr<const OpeningBook::Book> Book = nullptr;
+  size_t BookPlies = 0;
+
+  std::optional<std::chrono::milliseconds> MoveTime = std::nullopt;
+  std::optional<std::chrono::milliseconds> GameTime = std::nullopt;
+  std::array<std::chrono::milliseconds, 2> RemainingTime{};
+  std::optional<Color> TimeForfeitWinner = std::nullopt;
+
+  std::optional<size_t> MaxPlies = std::nullopt;
+  std::optional<size_t> Repetitions = std::nullopt;
+  std::unordered_map<Game::PositionKey, size_t> PositionCounts;
+  std::optional<DrawReason> Draw = std::nullopt;
+
+  void UpdateDraw();
+
+  std::optional<Game::Move> ProbeBook() const;
+  Strategy::SearchLimits GetSearchLimits(
+      const std::chrono::steady_clock::time_point start) const;
 
   void PrintData(std::ostream& stream = std::cout) const;
   void PrintBoard(std::ostream& stream = std::cout) const;
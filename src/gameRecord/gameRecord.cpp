@@ -0,0 +1,167 @@
+#include "gameRecord.h"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <iostream>
+
+namespace GameRecord {
+
+static constexpr uint32_t Magic = 0x52474E4F;  // "ONGR"
+static constexpr uint32_t Version = 1;
+
+static constexpr uint8_t DrawResult = 2;
+
+template <typename T>
+static void Append(std::vector<char>& buffer, const T value) {
+  const size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+static T Read(std::ifstream& stream) {
+  T value{};
+  stream.read((char*)&value, sizeof(T));
+  return value;
+}
+
+Game::Game Record::GetInitialGame() const {
+  return Game::Game(Dimensions.first, Dimensions.second, Cards);
+}
+
+Writer::Writer(std::ofstream&& stream, const size_t bufferSize)
+    : Stream(std::move(stream)), BufferSize(bufferSize) {
+  Buffer.reserve(BufferSize);
+}
+
+std::unique_ptr<Writer> Writer::Open(const std::filesystem::path& path,
+                                     const size_t bufferSize) {
+  std::ofstream stream;
+  stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!stream) {
+    std::cerr << std::format("Failed to open \"{}\"!", path.string())
+              << std::endl;
+    return nullptr;
+  }
+
+  stream.write((const char*)&Magic, sizeof(Magic));
+  stream.write((const char*)&Version, sizeof(Version));
+
+  return std::unique_ptr<Writer>(new Writer(std::move(stream), bufferSize));
+}
+
+Writer::~Writer() { Flush(); }
+
+void Writer::Write(const Record& record) {
+  if (record.Moves.size() > UINT16_MAX) {
+    throw std::invalid_argument(
+        std::format("Cannot record a game of {} plies", record.Moves.size()));
+  }
+
+  // Encode outside of the lock, so that threads only contend on the copy
+  std::vector<char> encoded;
+  encoded.reserve(16 + 2 * record.Moves.size());
+
+  Append<uint8_t>(encoded, record.Dimensions.first);
+  Append<uint8_t>(encoded, record.Dimensions.second);
+  for (const Game::Card card : record.Cards) {
+    Append<uint8_t>(encoded, (uint8_t)card.Type);
+  }
+  Append<uint32_t>(encoded, record.Seed);
+  Append<uint8_t>(encoded, record.Winner ? (uint8_t)record.Winner.value()
+                                         : DrawResult);
+  Append<uint16_t>(encoded, record.Moves.size());
+  for (const Game::Move move : record.Moves) {
+    Append<uint16_t>(encoded, move.Pack());
+  }
+
+  std::lock_guard lock(Mutex);
+  Buffer.insert(Buffer.end(), encoded.begin(), encoded.end());
+  RecordCount++;
+
+  if (Buffer.size() >= BufferSize) FlushLocked();
+}
+
+bool Writer::Flush() {
+  std::lock_guard lock(Mutex);
+  return FlushLocked();
+}
+
+bool Writer::FlushLocked() {
+  Stream.write(Buffer.data(), Buffer.size());
+  Stream.flush();
+  Buffer.clear();
+
+  return (bool)Stream;
+}
+
+std::optional<Reader> Reader::Open(const std::filesystem::path& path) {
+  if (!std::filesystem::is_regular_file(path)) {
+    std::cerr << std::format("\"{}\" is not a regular file!", path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  std::ifstream stream;
+  stream.open(path, std::ios::in | std::ios::binary);
+
+  if (Read<uint32_t>(stream) != Magic) {
+    std::cerr << std::format("\"{}\" is not a game record file!",
+                             path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  const uint32_t version = Read<uint32_t>(stream);
+  if (version != Version) {
+    std::cerr << std::format("Unsupported game record version {}!", version)
+              << std::endl;
+    return std::nullopt;
+  }
+
+  return Reader(std::move(stream));
+}
+
+std::optional<Record> Reader::Next() {
+  if (Error) return std::nullopt;
+  if (Stream.peek() == std::ifstream::traits_type::eof()) return std::nullopt;
+
+  Record record;
+  record.Dimensions.first = Read<uint8_t>(Stream);
+  record.Dimensions.second = Read<uint8_t>(Stream);
+  for (Game::Card& card : record.Cards) {
+    card.Type = (Game::CardType)Read<uint8_t>(Stream);
+  }
+  record.Seed = Read<uint32_t>(Stream);
+
+  const uint8_t result = Read<uint8_t>(Stream);
+  if (result != DrawResult) record.Winner = (Color)result;
+
+  const uint16_t moveCount = Read<uint16_t>(Stream);
+  record.Moves.reserve(moveCount);
+  for (uint16_t move = 0; move < moveCount; move++) {
+    record.Moves.push_back(Game::Move::Unpack(Read<uint16_t>(Stream)));
+  }
+
+  if (!Stream) {
+    std::cerr << "Game record file is truncated!" << std::endl;
+    Error = true;
+    return std::nullopt;
+  }
+
+  const bool validCards = std::ranges::all_of(
+      record.Cards, [](const Game::Card card) {
+        return card.Type < Game::CardType::CardTypeCount;
+      });
+  if (!validCards || result > DrawResult) {
+    std::cerr << "Game record file contains an invalid record!" << std::endl;
+    Error = true;
+    return std::nullopt;
+  }
+
+  return record;
+}
+
+}  // namespace GameRecord
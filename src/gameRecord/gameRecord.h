@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "../constants.h"
+#include "../game/game.h"
+#include "../util/color.h"
+
+namespace GameRecord {
+
+// Records are buffered in memory, and written out once this many bytes
+// have accumulated
+constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+struct Record {
+  std::pair<size_t, size_t> Dimensions = {5, 5};
+  std::array<Game::Card, CARD_COUNT> Cards;
+  // The seed the deal was drawn with
+  uint32_t Seed = 0;
+
+  std::vector<Game::Move> Moves;
+  // std::nullopt if the game was drawn
+  std::optional<Color> Winner = std::nullopt;
+
+  Game::Game GetInitialGame() const;
+
+  bool operator==(const Record& other) const = default;
+};
+
+// Appends records to a game record file. Write can be called from multiple
+// threads at once.
+class Writer {
+ public:
+  static std::unique_ptr<Writer> Open(
+      const std::filesystem::path& path,
+      const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+  ~Writer();
+
+  void Write(const Record& record);
+  bool Flush();
+
+  size_t GetRecordCount() const { return RecordCount; }
+
+ private:
+  Writer(std::ofstream&& stream, const size_t bufferSize);
+
+  bool FlushLocked();
+
+  std::mutex Mutex;
+  std::ofstream Stream;
+  std::vector<char> Buffer;
+  size_t BufferSize;
+  size_t RecordCount = 0;
+};
+
+class Reader {
+ public:
+  static std::optional<Reader> Open(const std::filesystem::path& path);
+
+  // Returns std::nullopt once all records have been read
+  std::optional<Record> Next();
+
+  // Whether reading stopped at a truncated or invalid record
+  bool HasError() const { return Error; }
+
+ private:
+  Reader(std::ifstream&& stream) : Stream(std::move(stream)) {}
+
+  std::ifstream Stream;
+  bool Error = false;
+};
+
+}  // namespace GameRecord
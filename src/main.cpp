@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "cli/cli.h"
+#include "util/allocations.h"
 
 void CommandLoop() {
   Cli::Cli cli;
@@ -42,5 +43,8 @@ int main(int argc, char* argv[]) {
     if (command) (*command)();
   }
 
+  if (Allocations::ENABLED)
+    std::cerr << "Allocations: " << Allocations::ToJson() << std::endl;
+
   return 0;
 }
\ No newline at end of file
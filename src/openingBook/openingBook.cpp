@@ -0,0 +1,241 @@
+#include "openingBook.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+namespace OpeningBook {
+
+static constexpr uint32_t Magic = 0x4B424E4F;  // "ONBK"
+static constexpr uint32_t Version = 1;
+
+static constexpr size_t HeaderSize = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+static constexpr size_t EntrySize =
+    2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+template <typename T>
+static void Write(std::ofstream& stream, const T value) {
+  stream.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static T Read(std::ifstream& stream) {
+  T value{};
+  stream.read((char*)&value, sizeof(T));
+  return value;
+}
+
+Book::Book(std::vector<Entry>&& entries) : Entries(std::move(entries)) {
+  std::sort(Entries.begin(), Entries.end(),
+            [](const Entry& first, const Entry& second) {
+              return first.Key < second.Key;
+            });
+}
+
+std::optional<Book> Book::Load(const std::filesystem::path& path) {
+  if (!std::filesystem::is_regular_file(path)) {
+    std::cerr << std::format("\"{}\" is not a regular file!", path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  std::ifstream stream;
+  stream.open(path, std::ios::in | std::ios::binary);
+
+  if (Read<uint32_t>(stream) != Magic) {
+    std::cerr << std::format("\"{}\" is not an opening book!", path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  const uint32_t version = Read<uint32_t>(stream);
+  if (version != Version) {
+    std::cerr << std::format("Unsupported opening book version {}!", version)
+              << std::endl;
+    return std::nullopt;
+  }
+
+  // Check the entry count against the file size, so that a corrupt count
+  // cannot make us reserve more memory than the entries could take up
+  const uint64_t entryCount = Read<uint64_t>(stream);
+  const uintmax_t fileSize = std::filesystem::file_size(path);
+  if (!stream || fileSize < HeaderSize ||
+      entryCount > (fileSize - HeaderSize) / EntrySize) {
+    std::cerr << std::format("Opening book \"{}\" is truncated!",
+                             path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  std::vector<Entry> entries;
+  entries.reserve(entryCount);
+  for (uint64_t entryId = 0; entryId < entryCount; entryId++) {
+    Entry entry;
+    entry.Key.High = Read<uint64_t>(stream);
+    entry.Key.Low = Read<uint64_t>(stream);
+    entry.Move = Read<uint16_t>(stream);
+    entry.Weight = Read<uint32_t>(stream);
+
+    if (!stream) {
+      std::cerr << std::format("Opening book \"{}\" is truncated!",
+                               path.string())
+                << std::endl;
+      return std::nullopt;
+    }
+
+    entries.push_back(entry);
+  }
+
+  return Book(std::move(entries));
+}
+
+bool Book::Save(const std::filesystem::path& path) const {
+  std::ofstream stream;
+  stream.open(path, std::ios::out | std::ios::binary);
+
+  if (!stream) {
+    std::cerr << std::format("Failed to open \"{}\"!", path.string())
+              << std::endl;
+    return false;
+  }
+
+  Write<uint32_t>(stream, Magic);
+  Write<uint32_t>(stream, Version);
+  Write<uint64_t>(stream, Entries.size());
+
+  for (const Entry& entry : Entries) {
+    Write<uint64_t>(stream, entry.Key.High);
+    Write<uint64_t>(stream, entry.Key.Low);
+    Write<uint16_t>(stream, entry.Move);
+    Write<uint32_t>(stream, entry.Weight);
+  }
+
+  return (bool)stream;
+}
+
+std::optional<Entry> Book::Find(const Game::PositionKey key) const {
+  const auto entryIt = std::lower_bound(
+      Entries.begin(), Entries.end(), key,
+      [](const Entry& entry, const Game::PositionKey key) {
+        return entry.Key < key;
+      });
+
+  if (entryIt == Entries.end() || entryIt->Key != key) return std::nullopt;
+  return *entryIt;
+}
+
+std::optional<Game::Move> Book::Probe(const Game::Game& game) const {
+  const std::optional<Entry> entry = Find(game.GetPositionKey());
+  if (!entry) return std::nullopt;
+
+  // Guard against a corrupt or mismatched book
+  const Game::Move move = Game::Move::Unpack(entry->Move);
+  if (!game.IsValidMove(move)) return std::nullopt;
+
+  return move;
+}
+
+void Builder::Add(const Game::Game& game, const Game::Move move,
+                  const size_t weight) {
+  Moves[game.GetPositionKey()][move.Pack()] += weight;
+}
+
+void Builder::AddFromGraph(const StateGraph::Graph& graph,
+                           const Game::Game& root, const size_t plies) {
+  std::vector<Game::Game> layer = {root};
+  std::unordered_set<Game::PositionKey> visited = {root.GetPositionKey()};
+
+  for (size_t ply = 0; ply < plies && !layer.empty(); ply++) {
+    std::vector<Game::Game> nextLayer;
+
+    for (const Game::Game& game : layer) {
+      const std::optional<std::weak_ptr<const StateGraph::Vertex>> found =
+          graph.Get(game);
+
+      if (found) {
+        const std::shared_ptr<const StateGraph::Vertex> vertex = found->lock();
+        const std::optional<Game::Move> optimalMove =
+            vertex == nullptr ? std::nullopt : vertex->GetOptimalMove();
+
+        // The vertex may be stored as a symmetric variant of the game,
+        // so look up the move that leads to the optimal target state
+        if (optimalMove) {
+          const Game::Game vertexGame =
+              Game::Game::FromSerialization(vertex->Serialization);
+          Game::Game optimalTarget(vertexGame);
+          optimalTarget.DoMove(optimalMove.value());
+
+          for (const Game::Move move : game.GetValidMoves()) {
+            Game::Game next(game);
+            next.DoMove(move);
+
+            if (StateGraph::EqualTo()(next, optimalTarget)) {
+              Add(game, move);
+              break;
+            }
+          }
+        }
+      }
+
+      for (const Game::Move move : game.GetValidMoves()) {
+        Game::Game next(game);
+        next.DoMove(move);
+
+        if (next.IsFinished()) continue;
+        if (!visited.insert(next.GetPositionKey()).second) continue;
+
+        nextLayer.push_back(std::move(next));
+      }
+    }
+
+    layer = std::move(nextLayer);
+  }
+}
+
+void Builder::AddFromSelfPlay(
+    const std::function<Game::Game()>& deal,
+    const std::function<std::unique_ptr<Strategy::Strategy>()>& strategy,
+    const size_t games, const size_t plies) {
+  for (size_t gameId = 0; gameId < games; gameId++) {
+    Game::Game game = deal();
+    const std::unique_ptr<Strategy::Strategy> redPlayer = strategy();
+    const std::unique_ptr<Strategy::Strategy> bluePlayer = strategy();
+
+    for (size_t ply = 0; ply < plies && !game.IsFinished(); ply++) {
+      Strategy::Strategy& player =
+          game.GetCurrentPlayer() == Color::Red ? *redPlayer : *bluePlayer;
+
+      const Game::Move move = player.GetMove(game, Strategy::SearchLimits());
+      Add(game, move);
+      game.DoMove(move);
+    }
+  }
+}
+
+Book Builder::Build() const {
+  std::vector<Entry> entries;
+  entries.reserve(Moves.size());
+
+  for (const auto& [key, moves] : Moves) {
+    const auto bestMoveIt = std::max_element(
+        moves.begin(), moves.end(),
+        [](const auto& first, const auto& second) {
+          // Break ties deterministically
+          if (first.second != second.second)
+            return first.second < second.second;
+          return first.first > second.first;
+        });
+
+    entries.push_back(Entry{
+        .Key = key,
+        .Move = bestMoveIt->first,
+        .Weight = (uint32_t)std::min<size_t>(bestMoveIt->second, UINT32_MAX),
+    });
+  }
+
+  return Book(std::move(entries));
+}
+
+}  // namespace OpeningBook
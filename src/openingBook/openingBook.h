@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "../game/game.h"
+#include "../stateGraph/stateGraph.h"
+#include "../strategies/strategy.h"
+
+namespace OpeningBook {
+
+struct Entry {
+  Game::PositionKey Key;
+  uint16_t Move;
+  uint32_t Weight;
+};
+
+class Book {
+ public:
+  Book() = default;
+  Book(std::vector<Entry>&& entries);
+
+  static std::optional<Book> Load(const std::filesystem::path& path);
+  bool Save(const std::filesystem::path& path) const;
+
+  std::optional<Game::Move> Probe(const Game::Game& game) const;
+  std::optional<Entry> Find(const Game::PositionKey key) const;
+
+  size_t GetSize() const { return Entries.size(); }
+  const std::vector<Entry>& GetEntries() const { return Entries; }
+
+ private:
+  // Sorted by key
+  std::vector<Entry> Entries;
+};
+
+class Builder {
+ public:
+  void Add(const Game::Game& game, const Game::Move move, size_t weight = 1);
+
+  void AddFromGraph(const StateGraph::Graph& graph, const Game::Game& root,
+                    const size_t plies);
+  void AddFromSelfPlay(
+      const std::function<Game::Game()>& deal,
+      const std::function<std::unique_ptr<Strategy::Strategy>()>& strategy,
+      const size_t games, const size_t plies);
+
+  Book Build() const;
+
+ private:
+  std::unordered_map<Game::PositionKey, std::unordered_map<uint16_t, size_t>>
+      Moves;
+};
+
+}  // namespace OpeningBook
@@ -0,0 +1,410 @@
+#include "positionDatabase.h"
+
+#include <algorithm>
+#include <deque>
+#include <format>
+#include <future>
+#include <iostream>
+#include <queue>
+
+#include "../gameRecord/gameRecord.h"
+#include "../util/parse.h"
+#include "../util/threadPool.h"
+
+namespace PositionDatabase {
+
+static constexpr uint32_t Magic = 0x44504E4F;  // "ONPD"
+static constexpr uint32_t Version = 1;
+
+static constexpr size_t HeaderSize = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+static constexpr size_t EntrySize =
+    2 * sizeof(uint64_t) + sizeof(uint16_t) + 3 * sizeof(uint32_t);
+
+template <typename T>
+static void Write(std::ostream& stream, const T value) {
+  stream.write((const char*)&value, sizeof(T));
+}
+
+template <typename T>
+static T Read(std::istream& stream) {
+  T value{};
+  stream.read((char*)&value, sizeof(T));
+  return value;
+}
+
+static void WriteEntry(std::ostream& stream, const Entry& entry) {
+  Write<uint64_t>(stream, entry.Key.High);
+  Write<uint64_t>(stream, entry.Key.Low);
+  Write<uint16_t>(stream, entry.Move);
+  Write<uint32_t>(stream, entry.Wins);
+  Write<uint32_t>(stream, entry.Draws);
+  Write<uint32_t>(stream, entry.Losses);
+}
+
+static Entry ReadEntry(std::istream& stream) {
+  Entry entry;
+  entry.Key.High = Read<uint64_t>(stream);
+  entry.Key.Low = Read<uint64_t>(stream);
+  entry.Move = Read<uint16_t>(stream);
+  entry.Wins = Read<uint32_t>(stream);
+  entry.Draws = Read<uint32_t>(stream);
+  entry.Losses = Read<uint32_t>(stream);
+  return entry;
+}
+
+static void Combine(Entry& entry, const Entry& other) {
+  entry.Wins += other.Wins;
+  entry.Draws += other.Draws;
+  entry.Losses += other.Losses;
+}
+
+double Entry::GetScore() const {
+  const size_t visits = GetVisits();
+  if (visits == 0) return 0.0;
+
+  return (Wins + 0.5 * Draws) / visits;
+}
+
+std::strong_ordering Entry::operator<=>(const Entry& other) const {
+  if (const std::strong_ordering order = Key <=> other.Key; order != 0)
+    return order;
+
+  return Move <=> other.Move;
+}
+
+size_t Position::GetVisits() const {
+  size_t visits = 0;
+  for (const Entry& entry : Moves) visits += entry.GetVisits();
+  return visits;
+}
+
+std::optional<Game::Move> Position::GetBestMove(const size_t minVisits) const {
+  const Entry* best = nullptr;
+  for (const Entry& entry : Moves) {
+    if (entry.GetVisits() < minVisits) continue;
+
+    if (best == nullptr || entry.GetScore() > best->GetScore() ||
+        (entry.GetScore() == best->GetScore() &&
+         entry.GetVisits() > best->GetVisits())) {
+      best = &entry;
+    }
+  }
+
+  if (best == nullptr) return std::nullopt;
+  return Game::Move::Unpack(best->Move);
+}
+
+std::optional<Database> Database::Open(const std::filesystem::path& path) {
+  if (!std::filesystem::is_regular_file(path)) {
+    std::cerr << std::format("\"{}\" is not a regular file!", path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  std::ifstream stream;
+  stream.open(path, std::ios::in | std::ios::binary);
+
+  if (Read<uint32_t>(stream) != Magic) {
+    std::cerr << std::format("\"{}\" is not a position database!",
+                             path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  const uint32_t version = Read<uint32_t>(stream);
+  if (version != Version) {
+    std::cerr << std::format("Unsupported position database version {}!",
+                             version)
+              << std::endl;
+    return std::nullopt;
+  }
+
+  // Compared by division, so that a corrupt count cannot overflow
+  const uint64_t entryCount = Read<uint64_t>(stream);
+  const uintmax_t fileSize = std::filesystem::file_size(path);
+  if (!stream || fileSize < HeaderSize ||
+      entryCount > (fileSize - HeaderSize) / EntrySize) {
+    std::cerr << std::format("Position database \"{}\" is truncated!",
+                             path.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  return Database(std::move(stream), entryCount);
+}
+
+Entry Database::ReadEntry(const size_t index) {
+  Stream.seekg(HeaderSize + index * EntrySize);
+  return PositionDatabase::ReadEntry(Stream);
+}
+
+Position Database::Find(const Game::PositionKey key) {
+  // Binary search for the first entry of the position
+  size_t low = 0;
+  size_t high = EntryCount;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (ReadEntry(middle).Key < key) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  Position position;
+  for (size_t index = low; index < EntryCount; index++) {
+    const Entry entry = ReadEntry(index);
+    if (entry.Key != key) break;
+    position.Moves.push_back(entry);
+  }
+
+  return position;
+}
+
+static std::filesystem::path GetRunPath(
+    const std::filesystem::path& databasePath, const size_t run) {
+  return std::format("{}.run{}", databasePath.string(), run);
+}
+
+// Replays a batch of games, and writes the results of every move played to
+// a sorted run file
+static std::optional<BuildInfo> WriteRun(
+    const std::vector<GameRecord::Record>& records,
+    const std::filesystem::path& runPath) {
+  BuildInfo info;
+
+  std::vector<Entry> entries;
+  for (const GameRecord::Record& record : records) {
+    const Parse::GameConfiguration configuration{.Dimensions =
+                                                     record.Dimensions};
+    if (!configuration.IsValid()) {
+      info.InvalidGameCount++;
+      continue;
+    }
+
+    const size_t gameStart = entries.size();
+    Game::Game game = record.GetInitialGame();
+
+    for (const Game::Move move : record.Moves) {
+      if (game.IsFinished() || !game.IsValidMove(move)) break;
+
+      Entry entry{.Key = game.GetPositionKey(), .Move = move.Pack()};
+      if (!record.Winner) {
+        entry.Draws = 1;
+      } else if (record.Winner == game.GetCurrentPlayer()) {
+        entry.Wins = 1;
+      } else {
+        entry.Losses = 1;
+      }
+
+      entries.push_back(entry);
+      game.DoMove(move);
+    }
+
+    if (entries.size() - gameStart != record.Moves.size()) {
+      entries.resize(gameStart);
+      info.InvalidGameCount++;
+      continue;
+    }
+
+    info.GameCount++;
+    info.PlyCount += record.Moves.size();
+  }
+
+  std::sort(entries.begin(), entries.end());
+
+  // Combine the results of the same move from the same position
+  std::vector<Entry>::iterator last = entries.begin();
+  for (std::vector<Entry>::iterator entry = entries.begin();
+       entry != entries.end(); entry++) {
+    if (entry != entries.begin() && last->SameMove(*entry)) {
+      Combine(*last, *entry);
+    } else if (entry != entries.begin()) {
+      *++last = *entry;
+    }
+  }
+  if (!entries.empty()) entries.erase(last + 1, entries.end());
+
+  std::ofstream stream;
+  stream.open(runPath, std::ios::out | std::ios::binary | std::ios::trunc);
+  for (const Entry& entry : entries) WriteEntry(stream, entry);
+
+  if (!stream) {
+    std::cerr << std::format("Failed to write \"{}\"!", runPath.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  info.RunCount = 1;
+  info.EntryCount = entries.size();
+  return info;
+}
+
+// Merges the sorted runs into the database, and returns its entry count
+static std::optional<size_t> MergeRuns(
+    const std::vector<std::filesystem::path>& runPaths,
+    const std::filesystem::path& databasePath) {
+  std::vector<std::ifstream> runs;
+  for (const std::filesystem::path& runPath : runPaths) {
+    runs.emplace_back(runPath, std::ios::in | std::ios::binary);
+  }
+
+  // The next entry of each run, smallest first
+  typedef std::pair<Entry, size_t> Head;
+  const auto compare = [](const Head& first, const Head& second) {
+    return first.first > second.first;
+  };
+  std::priority_queue<Head, std::vector<Head>, decltype(compare)> heads(
+      compare);
+
+  const auto advance = [&runs, &heads](const size_t run) {
+    const Entry entry = ReadEntry(runs[run]);
+    if (runs[run]) heads.emplace(entry, run);
+  };
+  for (size_t run = 0; run < runs.size(); run++) advance(run);
+
+  std::ofstream stream;
+  stream.open(databasePath,
+              std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!stream) {
+    std::cerr << std::format("Failed to open \"{}\"!", databasePath.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  Write<uint32_t>(stream, Magic);
+  Write<uint32_t>(stream, Version);
+  Write<uint64_t>(stream, 0);
+
+  uint64_t entryCount = 0;
+  std::optional<Entry> current = std::nullopt;
+  while (!heads.empty()) {
+    const auto [entry, run] = heads.top();
+    heads.pop();
+    advance(run);
+
+    if (current && current->SameMove(entry)) {
+      Combine(current.value(), entry);
+      continue;
+    }
+
+    if (current) {
+      WriteEntry(stream, current.value());
+      entryCount++;
+    }
+    current = entry;
+  }
+
+  if (current) {
+    WriteEntry(stream, current.value());
+    entryCount++;
+  }
+
+  stream.seekp(2 * sizeof(uint32_t));
+  Write<uint64_t>(stream, entryCount);
+
+  if (!stream) {
+    std::cerr << std::format("Failed to write \"{}\"!", databasePath.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  return entryCount;
+}
+
+std::optional<BuildInfo> Build(
+    const std::vector<std::filesystem::path>& recordPaths,
+    const std::filesystem::path& databasePath, const size_t threadCount,
+    const size_t runSize) {
+  BuildInfo info;
+  std::vector<std::filesystem::path> runPaths;
+  bool success = true;
+
+  const auto removeRuns = [&runPaths] {
+    for (const std::filesystem::path& runPath : runPaths) {
+      std::filesystem::remove(runPath);
+    }
+  };
+
+  {
+    ThreadPool pool(threadCount);
+
+    // Each batch in flight holds up to a run of entries in memory
+    const size_t maxInFlight = pool.GetThreadCount();
+    std::deque<std::future<std::optional<BuildInfo>>> inFlight;
+
+    const auto collect = [&info, &inFlight, &success] {
+      const std::optional<BuildInfo> runInfo = inFlight.front().get();
+      inFlight.pop_front();
+
+      if (!runInfo) {
+        success = false;
+        return;
+      }
+
+      info.GameCount += runInfo->GameCount;
+      info.InvalidGameCount += runInfo->InvalidGameCount;
+      info.PlyCount += runInfo->PlyCount;
+      info.RunCount += runInfo->RunCount;
+    };
+
+    std::vector<GameRecord::Record> batch;
+    size_t batchPlies = 0;
+
+    const auto submit = [&] {
+      runPaths.push_back(GetRunPath(databasePath, runPaths.size()));
+      inFlight.push_back(
+          pool.Submit([records = std::move(batch), runPath = runPaths.back()] {
+            return WriteRun(records, runPath);
+          }));
+
+      batch.clear();
+      batchPlies = 0;
+
+      while (inFlight.size() > maxInFlight) collect();
+    };
+
+    for (const std::filesystem::path& recordPath : recordPaths) {
+      std::optional<GameRecord::Reader> reader =
+          GameRecord::Reader::Open(recordPath);
+      if (!reader) {
+        success = false;
+        break;
+      }
+
+      for (std::optional<GameRecord::Record> record = reader->Next(); record;
+           record = reader->Next()) {
+        batchPlies += record->Moves.size();
+        batch.push_back(std::move(record.value()));
+
+        if (batchPlies >= runSize) submit();
+      }
+
+      // A database built from part of a file would silently miss games
+      if (reader->HasError()) {
+        std::cerr << std::format("Failed to read all games from \"{}\"!",
+                                 recordPath.string())
+                  << std::endl;
+        success = false;
+        break;
+      }
+    }
+
+    if (success && !batch.empty()) submit();
+    while (!inFlight.empty()) collect();
+  }
+
+  if (!success) {
+    removeRuns();
+    return std::nullopt;
+  }
+
+  const std::optional<size_t> entryCount = MergeRuns(runPaths, databasePath);
+  removeRuns();
+  if (!entryCount) return std::nullopt;
+
+  info.EntryCount = entryCount.value();
+  return info;
+}
+
+}  // namespace PositionDatabase
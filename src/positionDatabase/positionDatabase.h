@@ -0,0 +1,83 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+#include "../game/game.h"
+
+namespace PositionDatabase {
+
+// The number of entries gathered into each sorted run while building
+constexpr size_t DEFAULT_RUN_SIZE = 1 << 22;
+
+// The results of a move played from a position, from the point of view of
+// the player that made it
+struct Entry {
+  Game::PositionKey Key;
+  uint16_t Move = 0;
+  uint32_t Wins = 0;
+  uint32_t Draws = 0;
+  uint32_t Losses = 0;
+
+  size_t GetVisits() const { return (size_t)Wins + Draws + Losses; }
+  // The expected score of the move, between 0 and 1
+  double GetScore() const;
+
+  // Orders by key, then by move
+  std::strong_ordering operator<=>(const Entry& other) const;
+  bool SameMove(const Entry& other) const {
+    return Key == other.Key && Move == other.Move;
+  }
+};
+
+// The combined results of all moves played from a position
+struct Position {
+  std::vector<Entry> Moves;
+
+  size_t GetVisits() const;
+  // The move with the highest score among those played at least
+  // `minVisits` times
+  std::optional<Game::Move> GetBestMove(const size_t minVisits = 1) const;
+};
+
+// A database file holds its entries sorted, and is searched on disk, so
+// that it need not fit in memory. Not thread-safe; each thread should open
+// its own Database.
+class Database {
+ public:
+  static std::optional<Database> Open(const std::filesystem::path& path);
+
+  Position Find(const Game::PositionKey key);
+  Position Find(const Game::Game& game) { return Find(game.GetPositionKey()); }
+
+  size_t GetSize() const { return EntryCount; }
+
+ private:
+  Database(std::ifstream&& stream, const size_t entryCount)
+      : Stream(std::move(stream)), EntryCount(entryCount) {}
+
+  Entry ReadEntry(const size_t index);
+
+  std::ifstream Stream;
+  size_t EntryCount;
+};
+
+struct BuildInfo {
+  size_t GameCount = 0;
+  size_t InvalidGameCount = 0;
+  size_t PlyCount = 0;
+  size_t RunCount = 0;
+  size_t EntryCount = 0;
+};
+
+// Builds a database from game record files. The positions of each batch of
+// games are sorted into a run on a thread pool and written to a temporary
+// file, after which all runs are merged into the database.
+std::optional<BuildInfo> Build(
+    const std::vector<std::filesystem::path>& recordPaths,
+    const std::filesystem::path& databasePath, const size_t threadCount = 0,
+    const size_t runSize = DEFAULT_RUN_SIZE);
+
+}  // namespace PositionDatabase
@@ -0,0 +1,118 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <new>
+
+#include "../util/allocations.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace StateGraph {
+
+// The part of a block the current thread has yet to hand out
+struct Region {
+  uint64_t ArenaId = 0;
+  char* Next = nullptr;
+  char* End = nullptr;
+};
+
+static thread_local Region CurrentRegion;
+static std::atomic<uint64_t> NextArenaId = 1;
+
+Arena::Arena() : Id(NextArenaId.fetch_add(1, std::memory_order_relaxed)) {}
+
+Arena::~Arena() {
+  if constexpr (Allocations::ENABLED) {
+    Allocations::Release(Allocations::Subsystem::StateGraph, ObjectCount,
+                         ObjectBytes);
+  }
+
+  for (const auto [memory, size] : Blocks) {
+    ::operator delete(memory, size, std::align_val_t(ARENA_BLOCK_SIZE));
+  }
+}
+
+void* Arena::Allocate(const size_t size, const size_t alignment) {
+  assert(alignment <= alignof(std::max_align_t));
+
+  if constexpr (Allocations::ENABLED) {
+    ObjectCount.fetch_add(1, std::memory_order_relaxed);
+    ObjectBytes.fetch_add(size, std::memory_order_relaxed);
+    Allocations::Record(Allocations::Subsystem::StateGraph, size);
+  }
+
+  Region& region = CurrentRegion;
+  if (region.ArenaId == Id) {
+    void* next = region.Next;
+    size_t space = region.End - region.Next;
+    if (std::align(alignment, size, next, space)) {
+      region.Next = static_cast<char*>(next) + size;
+      return next;
+    }
+  }
+
+  StartBlock(size);
+  void* memory = region.Next;
+  region.Next += size;
+  return memory;
+}
+
+void Arena::Detach() {
+  Region& region = CurrentRegion;
+  if (region.ArenaId != Id) return;
+
+  // Spares start aligned for any object, as Allocate does not align the first
+  // object of a block
+  void* next = region.Next;
+  size_t space = region.End - region.Next;
+  if (std::align(alignof(std::max_align_t), 1, next, space)) {
+    const std::lock_guard<std::mutex> lock(Mutex);
+    Spares.emplace_back(static_cast<char*>(next), region.End);
+  }
+
+  region = Region();
+}
+
+void Arena::StartBlock(const size_t size) {
+  {
+    const std::lock_guard<std::mutex> lock(Mutex);
+    const auto spare =
+        std::find_if(Spares.begin(), Spares.end(), [size](const auto spare) {
+          return (size_t)(spare.second - spare.first) >= size;
+        });
+    if (spare != Spares.end()) {
+      CurrentRegion = {
+          .ArenaId = Id, .Next = spare->first, .End = spare->second};
+      *spare = Spares.back();
+      Spares.pop_back();
+      return;
+    }
+  }
+
+  // Oversized objects get a block of their own, rounded up to whole blocks
+  const size_t blockSize =
+      (std::max(size, ARENA_BLOCK_SIZE) + ARENA_BLOCK_SIZE - 1) /
+      ARENA_BLOCK_SIZE * ARENA_BLOCK_SIZE;
+  void* memory =
+      ::operator new(blockSize, std::align_val_t(ARENA_BLOCK_SIZE));
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (UseHugePages) madvise(memory, blockSize, MADV_HUGEPAGE);
+#endif
+
+  {
+    const std::lock_guard<std::mutex> lock(Mutex);
+    Blocks.emplace_back(memory, blockSize);
+  }
+  ReservedBytes.fetch_add(blockSize, std::memory_order_relaxed);
+
+  CurrentRegion = {.ArenaId = Id,
+                   .Next = static_cast<char*>(memory),
+                   .End = static_cast<char*>(memory) + blockSize};
+}
+
+}  // namespace StateGraph
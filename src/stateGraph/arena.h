@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace StateGraph {
+
+// The size of the blocks arenas take from the system, that of a huge page
+constexpr size_t ARENA_BLOCK_SIZE = size_t{2} << 20;
+
+// Whether arenas ask the system to back their blocks with transparent huge
+// pages, where it supports them
+inline bool UseHugePages = false;
+
+// Hands out the memory of the vertices and edges of a graph from large
+// blocks, which are all released at once when the arena is destroyed. Each
+// thread bumps through a block of its own, so that allocating takes no lock
+// but when a block runs out. Freeing a single object gives nothing back.
+class Arena {
+ public:
+  Arena();
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment);
+  // Hands the rest of the calling thread's block back to the arena, for the
+  // next thread that needs a block. Threads that end before the arena should
+  // call this, or the rest of their block goes unused.
+  void Detach();
+
+  // The bytes of the blocks taken from the system
+  size_t GetReservedBytes() const {
+    return ReservedBytes.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Starts a new block for the calling thread, large enough for `size` bytes
+  void StartBlock(size_t size);
+
+  // Tells the blocks of this arena from those of an earlier arena at the
+  // same address
+  const uint64_t Id;
+
+  std::mutex Mutex;
+  std::vector<std::pair<void*, size_t>> Blocks;
+  // The unused ends of blocks handed back by threads
+  std::vector<std::pair<char*, char*>> Spares;
+  std::atomic<size_t> ReservedBytes = 0;
+
+  // The objects handed out, for allocation profiling. Their blocks come from
+  // an operator new that the profiler does not replace.
+  std::atomic<size_t> ObjectCount = 0;
+  std::atomic<size_t> ObjectBytes = 0;
+};
+
+// Allocates from an arena, for std::allocate_shared
+template <class T>
+struct ArenaAllocator {
+  typedef T value_type;
+
+  ArenaAllocator(Arena* arena) : Owner(arena) {}
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : Owner(other.Owner) {}
+
+  T* allocate(const size_t count) {
+    return static_cast<T*>(Owner->Allocate(count * sizeof(T), alignof(T)));
+  }
+  // Released along with the arena
+  void deallocate(T*, size_t) {}
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return Owner == other.Owner;
+  }
+
+  Arena* Owner;
+};
+
+}  // namespace StateGraph
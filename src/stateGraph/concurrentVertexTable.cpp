@@ -0,0 +1,86 @@
+#include "concurrentVertexTable.h"
+
+#include "../util/stats.h"
+
+namespace StateGraph {
+
+ConcurrentVertexTable::ConcurrentVertexTable(Graph& graph) : Owner(graph) {
+  Take();
+}
+
+ConcurrentVertexTable::~ConcurrentVertexTable() {
+  if (Holding) Release();
+}
+
+void ConcurrentVertexTable::Release() {
+  Owner.Vertices.reserve(Owner.Vertices.size() + size());
+
+  for (Shard& shard : Shards) {
+    for (auto& [key, vertex] : shard.Vertices) {
+      Owner.Vertices.emplace(key, std::move(vertex));
+    }
+    shard.Vertices.clear();
+  }
+
+  Size = 0;
+  Holding = false;
+}
+
+void ConcurrentVertexTable::Take() {
+  for (auto& [key, vertex] : Owner.Vertices) {
+    const bool expanded = vertex->Quality.has_value() || !vertex->Edges.empty();
+
+    VertexTable& vertices = GetShard(key).Vertices;
+    const VertexTable::iterator entry =
+        vertices.emplace(key, std::move(vertex)).first;
+    vertices.SetFlag(entry, expanded);
+  }
+
+  Size = Owner.Vertices.size();
+  Owner.Vertices.clear();
+  Holding = true;
+}
+
+std::pair<std::shared_ptr<Vertex>, bool> ConcurrentVertexTable::Claim(
+    const Game::Game& game) {
+  const auto [vertex, claimed] = Find(game, true);
+  return {vertex, !claimed};
+}
+
+std::pair<std::shared_ptr<Vertex>, bool> ConcurrentVertexTable::Insert(
+    const Game::Game& game) {
+  return Find(game, false);
+}
+
+bool ConcurrentVertexTable::IsClaimed(const Game::Game& game) const {
+  const Game::PositionKey key = VertexTable::GetKey(game);
+  const Shard& shard = GetShard(key);
+
+  std::unique_lock<std::mutex> lock(shard.Mutex, std::defer_lock);
+  Stats::LockCounted([&lock] { lock.lock(); });
+
+  const VertexTable::const_iterator entry = shard.Vertices.find(key);
+  return entry != shard.Vertices.end() && shard.Vertices.GetFlag(entry);
+}
+
+std::pair<std::shared_ptr<Vertex>, bool> ConcurrentVertexTable::Find(
+    const Game::Game& game, const bool claim) {
+  const Game::PositionKey key = VertexTable::GetKey(game);
+  Shard& shard = GetShard(key);
+
+  std::unique_lock<std::mutex> lock(shard.Mutex, std::defer_lock);
+  Stats::LockCounted([&lock] { lock.lock(); });
+
+  VertexTable::iterator entry = shard.Vertices.find(key);
+  if (entry == shard.Vertices.end()) {
+    entry = shard.Vertices.emplace(key, Owner.MakeVertex(game)).first;
+    Size.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const bool claimed = shard.Vertices.GetFlag(entry);
+  if (claim) shard.Vertices.SetFlag(entry, true);
+
+  return {entry->second, claimed};
+}
+
+}  // namespace StateGraph
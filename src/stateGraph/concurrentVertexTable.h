@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include "stateGraph.h"
+
+namespace StateGraph {
+
+// The vertices of a graph under construction by several threads, split over
+// shards that each lock on their own, so that threads rarely wait on one
+// another. A thread claims a vertex before expanding it, and the claim
+// succeeds only once, so that no vertex is expanded twice.
+class ConcurrentVertexTable {
+ public:
+  // Moves the vertices of `graph` in, claiming those already expanded
+  explicit ConcurrentVertexTable(Graph& graph);
+  // Moves the vertices back into the graph, unless they already were
+  ~ConcurrentVertexTable();
+
+  ConcurrentVertexTable(const ConcurrentVertexTable&) = delete;
+  ConcurrentVertexTable& operator=(const ConcurrentVertexTable&) = delete;
+
+  // Moves the vertices back into the graph, for it to be used while no thread
+  // uses the table
+  void Release();
+  // Moves the vertices of the graph in again after a release
+  void Take();
+
+  // Finds the vertex of `game`, creating it if there is none yet, and claims
+  // it. Returns the vertex, and whether this call claimed it.
+  std::pair<std::shared_ptr<Vertex>, bool> Claim(const Game::Game& game);
+  // Finds the vertex of `game`, creating it if there is none yet. Returns the
+  // vertex, and whether it has been claimed.
+  std::pair<std::shared_ptr<Vertex>, bool> Insert(const Game::Game& game);
+
+  bool IsClaimed(const Game::Game& game) const;
+
+  size_t size() const { return Size.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr size_t SHARD_BITS = 6;
+  static constexpr size_t SHARD_COUNT = size_t{1} << SHARD_BITS;
+
+  // Kept on cache lines of their own, so that locking one shard does not slow
+  // down threads working on its neighbours
+  struct alignas(64) Shard {
+    mutable std::mutex Mutex;
+    VertexTable Vertices;
+  };
+
+  // Picks the shard by the high bits of the hash, as each shard places its
+  // vertices by the low bits
+  Shard& GetShard(const Game::PositionKey& key) {
+    return Shards[VertexTable::Hash(key) >> (64 - SHARD_BITS)];
+  }
+  const Shard& GetShard(const Game::PositionKey& key) const {
+    return Shards[VertexTable::Hash(key) >> (64 - SHARD_BITS)];
+  }
+
+  // Finds or creates the vertex of `game` with its shard locked, and claims it
+  // if `claim`. Returns the vertex, and whether it was claimed before.
+  std::pair<std::shared_ptr<Vertex>, bool> Find(const Game::Game& game,
+                                                bool claim);
+
+  Graph& Owner;
+  bool Holding = false;
+
+  std::array<Shard, SHARD_COUNT> Shards;
+  std::atomic<size_t> Size = 0;
+};
+
+}  // namespace StateGraph
@@ -0,0 +1,117 @@
+#include "csrGraph.h"
+
+#include <cassert>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "../util/allocations.h"
+#include "../util/trace.h"
+
+namespace StateGraph {
+
+static EdgeLabel ToLabel(const std::optional<bool> optimal) {
+  if (!optimal) return EdgeLabel::Unlabelled;
+  return optimal.value() ? EdgeLabel::Optimal : EdgeLabel::NotOptimal;
+}
+
+static std::optional<bool> ToOptimal(const EdgeLabel label) {
+  switch (label) {
+    case EdgeLabel::NotOptimal:
+      return false;
+    case EdgeLabel::Optimal:
+      return true;
+    default:
+      return std::nullopt;
+  }
+}
+
+CsrGraph CsrGraph::FromGraph(const Graph& graph) {
+  const Trace::Scope scope("CsrGraph::FromGraph");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+
+  if (graph.Vertices.size() > std::numeric_limits<VertexId>::max()) {
+    const std::string err = std::format(
+        "{} vertices do not fit in a compressed sparse row graph!",
+        graph.Vertices.size());
+    throw std::runtime_error(err);
+  }
+
+  CsrGraph csr;
+  csr.Serializations.reserve(graph.Vertices.size());
+  csr.Qualities.reserve(graph.Vertices.size());
+  csr.Offsets.reserve(graph.Vertices.size() + 1);
+
+  std::unordered_map<const Vertex*, VertexId> ids;
+  ids.reserve(graph.Vertices.size());
+  for (const auto& [_, vertex] : graph.Vertices) {
+    ids.emplace(vertex.get(), csr.Serializations.size());
+    csr.Serializations.push_back(vertex->Serialization);
+    csr.Qualities.push_back(vertex->Quality);
+  }
+
+  const size_t edgeCount = graph.GetEdgeCount();
+  csr.Targets.reserve(edgeCount);
+  csr.Moves.reserve(edgeCount);
+  csr.Labels.reserve(edgeCount);
+
+  for (const auto& [_, vertex] : graph.Vertices) {
+    for (const std::shared_ptr<const Edge> edge : vertex->Edges) {
+      const std::shared_ptr<const Vertex> target = edge->Target.lock();
+      assert(target != nullptr);
+
+      csr.Targets.push_back(ids.at(target.get()));
+      csr.Moves.push_back(edge->Move.Pack());
+      csr.Labels.push_back(ToLabel(edge->Optimal));
+    }
+    csr.Offsets.push_back(csr.Targets.size());
+  }
+
+  return csr;
+}
+
+Graph CsrGraph::ToGraph() const {
+  const Trace::Scope scope("CsrGraph::ToGraph");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+
+  Graph graph;
+  graph.Reserve(GetVertexCount());
+
+  std::vector<std::shared_ptr<Vertex>> vertices;
+  vertices.reserve(GetVertexCount());
+  for (VertexId vertex = 0; vertex < GetVertexCount(); vertex++) {
+    vertices.push_back(
+        graph.MakeVertex(Serializations[vertex], Qualities[vertex]));
+    graph.Vertices.emplace(
+        Game::Game::FromSerialization(Serializations[vertex]),
+        vertices.back());
+  }
+
+  for (VertexId vertex = 0; vertex < GetVertexCount(); vertex++) {
+    const std::shared_ptr<Vertex>& source = vertices[vertex];
+    source->Edges.reserve(GetEdgesEnd(vertex) - GetEdgesBegin(vertex));
+
+    for (EdgeId edge = GetEdgesBegin(vertex); edge < GetEdgesEnd(vertex);
+         edge++) {
+      source->Edges.emplace_back(graph.MakeEdge(
+          source, vertices[Targets[edge]], Game::Move::Unpack(Moves[edge]),
+          ToOptimal(Labels[edge])));
+    }
+  }
+
+  return graph;
+}
+
+void CsrGraph::SetOptimalEdge(const VertexId vertex, const EdgeId optimal) {
+  for (EdgeId edge = GetEdgesBegin(vertex); edge < GetEdgesEnd(vertex);
+       edge++) {
+    if (edge == optimal) {
+      Labels[edge] = EdgeLabel::Optimal;
+    } else if (Labels[edge] != EdgeLabel::Unlabelled) {
+      Labels[edge] = EdgeLabel::NotOptimal;
+    }
+  }
+}
+
+}  // namespace StateGraph
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "stateGraph.h"
+
+namespace StateGraph {
+
+typedef uint32_t VertexId;
+typedef uint64_t EdgeId;
+
+// The label retrograde analysis gives an edge, like Edge::Optimal
+enum class EdgeLabel : uint8_t {
+  Unlabelled,
+  NotOptimal,
+  Optimal,
+};
+
+// A state graph in compressed sparse row form. Vertices are numbered, and the
+// edges out of each vertex lie next to each other in flat arrays, so that an
+// edge takes 7 bytes and traversing the graph chases no pointers. Its
+// topology is fixed once built, so it suits analysis rather than
+// construction.
+struct CsrGraph {
+ public:
+  static CsrGraph FromGraph(const Graph& graph);
+  Graph ToGraph() const;
+
+  size_t GetVertexCount() const { return Serializations.size(); }
+  size_t GetEdgeCount() const { return Targets.size(); }
+
+  EdgeId GetEdgesBegin(const VertexId vertex) const { return Offsets[vertex]; }
+  EdgeId GetEdgesEnd(const VertexId vertex) const {
+    return Offsets[vertex + 1];
+  }
+
+  // Labels the edges out of `vertex` like Vertex::SetOptimalMove
+  void SetOptimalEdge(VertexId vertex, EdgeId edge);
+
+  std::vector<Game::GameSerialization> Serializations;
+  std::vector<std::optional<WinState>> Qualities;
+
+  // The edges out of each vertex, from its offset up to that of the next
+  std::vector<EdgeId> Offsets = {0};
+  std::vector<VertexId> Targets;
+  // Packed by Game::Move::Pack
+  std::vector<uint16_t> Moves;
+  std::vector<EdgeLabel> Labels;
+};
+
+}  // namespace StateGraph
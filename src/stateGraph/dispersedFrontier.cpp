@@ -1,38 +1,30 @@
 #include <cassert>
 #include <chrono>
 #include <future>
-#include <shared_mutex>
 #include <unordered_set>
 
+#include "../util/allocations.h"
+#include "../util/progress.h"
+#include "../util/stats.h"
+#include "../util/trace.h"
+#include "concurrentVertexTable.h"
 #include "strategies.h"
 
 namespace StateGraph {
 namespace Strategies {
 namespace DF {
 
-struct VertexInfo {
-  VertexInfo(Game::GameSerialization game) : Game(game) {}
-  VertexInfo(Game::Game game) : Game(game.Serialize()) {}
-
-  Game::GameSerialization Game;
-  std::vector<Game::Move> Edges;
-};
-
 struct ThreadContext {
-  std::unordered_map<Game::Game, VertexInfo, Hash, EqualTo> LocalVertices;
   std::unordered_set<Game::Game, Hash, EqualTo> Frontier;
 
   std::optional<std::future<void>> thread = std::nullopt;
 
   bool InUse() const { return thread.has_value(); }
 
-  void Finish(std::unordered_map<Game::Game, std::shared_ptr<Vertex>, Hash,
-                                 EqualTo>& globalVertices,
-              std::unordered_set<Game::Game, Hash, EqualTo>& globalFrontier,
-              std::shared_mutex& mutex);
+  void Finish(const ConcurrentVertexTable& vertices,
+              std::unordered_set<Game::Game, Hash, EqualTo>& globalFrontier);
 
   void Reset() {
-    LocalVertices.clear();
     Frontier.clear();
     thread = std::nullopt;
   }
@@ -43,103 +35,73 @@ struct ThreadContext {
 using namespace std::chrono_literals;
 using namespace DF;
 
-static void Explore(
-    const Game::Game game,
-    std::unordered_map<Game::Game, VertexInfo, Hash, EqualTo>& localVertices,
-    std::unordered_set<Game::Game, Hash, EqualTo>& frontier,
-    const std::unordered_map<Game::Game, std::shared_ptr<Vertex>, Hash,
-                             EqualTo>& globalVertices,
-    const size_t depth, const size_t maxDepth, std::shared_mutex& mutex) {
-  // Check frontier depth
-  if (depth >= maxDepth) {
-    frontier.emplace(game);
-    return;
-  }
-
-  // Update local vertices
-  VertexInfo& vertex =
-      localVertices.emplace(game, VertexInfo(game)).first->second;
-
-  // Analyse moves
-  vertex.Edges = game.GetValidMoves();
-  for (const Game::Move move : vertex.Edges) {
+// Expands the claimed vertex of `game`, and claims and expands its successors
+// up to `maxDepth`. Successors at that depth are left to the frontier.
+static void Explore(const Game::Game& game,
+                    const std::shared_ptr<Vertex>& vertex,
+                    ConcurrentVertexTable& vertices, Graph& graph,
+                    std::unordered_set<Game::Game, Hash, EqualTo>& frontier,
+                    const size_t depth, const size_t maxDepth) {
+  for (const Game::Move move : game.GetValidMoves()) {
     Game::Game next(game);
     next.DoMove(move);
 
-    // Don't explore already explored states
-    if (localVertices.contains(next)) continue;
+    // Having claimed the vertex, this thread alone adds its edges
+    if (depth + 1 < maxDepth) {
+      const auto [nextVertex, claimed] = vertices.Claim(next);
+      vertex->Edges.emplace_back(graph.MakeEdge(vertex, nextVertex, move));
+      Progress::Add(Progress::Current.Edges);
 
-    // If the global is locked, don't waste time and just keep going,
-    // assuming it has not yet been explored
-    if (mutex.try_lock_shared()) {
-      const bool explored = globalVertices.contains(next);
-      mutex.unlock_shared();
+      // Venture forth, unless another thread already has
+      if (claimed) {
+        Explore(next, nextVertex, vertices, graph, frontier, depth + 1,
+                maxDepth);
+      }
+    } else {
+      const auto [nextVertex, claimed] = vertices.Insert(next);
+      vertex->Edges.emplace_back(graph.MakeEdge(vertex, nextVertex, move));
+      Progress::Add(Progress::Current.Edges);
 
-      if (explored) continue;
+      if (!claimed) frontier.insert(std::move(next));
     }
-
-    // Venture forth
-    Explore(std::move(next), localVertices, frontier, globalVertices, depth + 1,
-            maxDepth, mutex);
   }
+
+  Progress::Add(Progress::Current.Expansions);
 }
 
 void ThreadContext::Finish(
-    std::unordered_map<Game::Game, std::shared_ptr<Vertex>, Hash, EqualTo>&
-        globalVertices,
-    std::unordered_set<Game::Game, Hash, EqualTo>& globalFrontier,
-    std::shared_mutex& mutex) {
-  mutex.lock();
-
-  // Add found vertices
-  for (const auto [game, localVertex] : LocalVertices) {
-    const std::shared_ptr<Vertex> vertex =
-        globalVertices.emplace(game, std::make_shared<Vertex>(game))
-            .first->second;
-
-    // Add edges
-    assert(localVertex.Edges.size() == game.GetValidMoves().size());
-    for (Game::Move move : localVertex.Edges) {
-      Game::Game nextGame(game);
-      nextGame.DoMove(move);
-
-      const std::shared_ptr<Vertex> nextVertex =
-          globalVertices.emplace(nextGame, std::make_shared<Vertex>(nextGame))
-              .first->second;
-
-      // Only add if not already there
-      if (std::none_of(vertex->Edges.begin(), vertex->Edges.end(),
-                       [move](const std::shared_ptr<Edge> edge) {
-                         return edge->Move == move;
-                       })) {
-        vertex->Edges.emplace_back(
-            std::make_shared<Edge>(vertex, nextVertex, move));
-      }
-    }
-  }
+    const ConcurrentVertexTable& vertices,
+    std::unordered_set<Game::Game, Hash, EqualTo>& globalFrontier) {
+  const Trace::Scope scope("Merge");
 
-  // Update frontier
+  // Other threads may have expanded part of the frontier in the meantime
   for (const Game::Game& frontierGame : Frontier) {
-    std::shared_ptr<Vertex> vertex = globalVertices.at(frontierGame);
-    const bool expanded = vertex->Quality.has_value() || !vertex->Edges.empty();
-
-    if (expanded) {
-      globalFrontier.erase(frontierGame);
-    } else {
-      globalFrontier.insert(frontierGame);
-    }
+    if (!vertices.IsClaimed(frontierGame)) globalFrontier.insert(frontierGame);
   }
 
-  mutex.unlock();
+  Progress::Set(Progress::Current.Vertices, vertices.size());
+  Progress::Set(Progress::Current.Frontier, globalFrontier.size());
+
   Reset();
 }
 
 void DispersedFrontier(Graph& graph, const Game::Game game, const size_t depth,
                        const size_t maxThreadCount,
-                       std::optional<SaveParameters> saveParameters) {
-  std::unordered_set<Game::Game, Hash, EqualTo> frontier = {game};
-
-  std::shared_mutex mutex;
+                       std::optional<SaveParameters> saveParameters,
+                       const std::function<bool()>& shouldStop) {
+  const Trace::Scope scope("DispersedFrontier");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+  const Progress::PhaseScope phase("dispersed frontier");
+  Progress::Set(Progress::Current.Edges, graph.GetEdgeCount());
+
+  // A graph saved by a run that was stopped early continues from the vertices
+  // that run left unexpanded, as the table considers the rest claimed
+  graph.Insert(game);
+  std::unordered_set<Game::Game, Hash, EqualTo> frontier;
+  for (const std::shared_ptr<Vertex>& vertex : graph.GetUnexpanded(game))
+    frontier.insert(Game::Game::FromSerialization(vertex->Serialization));
+
+  ConcurrentVertexTable vertices(graph);
   std::vector<ThreadContext> threadContexts(maxThreadCount);
 
   const auto anyThreadActive = [&threadContexts] {
@@ -148,9 +110,25 @@ void DispersedFrontier(Graph& graph, const Game::Game game, const size_t depth,
         [](const ThreadContext& context) { return context.InUse(); });
   };
 
+  // Lets the active threads finish, so that their work is kept
+  const auto finishAll = [&threadContexts, &vertices, &frontier] {
+    for (ThreadContext& context : threadContexts) {
+      if (!context.InUse()) continue;
+
+      context.thread->wait();
+      context.Finish(vertices, frontier);
+    }
+  };
+
   if (saveParameters) saveParameters->StartTimers();
 
-  do {
+  while (!frontier.empty() || anyThreadActive()) {
+    if (shouldStop && shouldStop()) {
+      finishAll();
+      vertices.Release();
+      return;
+    }
+
     if (frontier.empty()) {
       // Wait for the first thread to finish
 
@@ -159,7 +137,7 @@ void DispersedFrontier(Graph& graph, const Game::Game game, const size_t depth,
         if (!context.InUse()) continue;
 
         if (context.thread->wait_for(0ms) == std::future_status::ready) {
-          context.Finish(graph.Vertices, frontier, mutex);
+          context.Finish(vertices, frontier);
           break;
         }
       }
@@ -179,12 +157,14 @@ void DispersedFrontier(Graph& graph, const Game::Game game, const size_t depth,
 
         // A finished thread is idling
         if (context.thread->wait_for(0ms) == std::future_status::ready) {
-          context.Finish(graph.Vertices, frontier, mutex);
+          context.Finish(vertices, frontier);
 
+          // The graph holds the vertices only while no thread is active
           if (saveParameters && saveParameters->ShouldSave()) {
-            mutex.lock_shared();
+            finishAll();
+            vertices.Release();
             saveParameters->Save(graph);
-            mutex.unlock_shared();
+            vertices.Take();
           }
 
           idleContext = &context;
@@ -196,14 +176,27 @@ void DispersedFrontier(Graph& graph, const Game::Game game, const size_t depth,
     // Put the idle thread to work
     const Game::Game state = *frontier.begin();
     frontier.erase(state);
+    Progress::Set(Progress::Current.Frontier, frontier.size());
 
     idleContext->thread = std::async(
-        std::launch::async, [state, idleContext, &graph, depth, &mutex]() {
-          Explore(std::move(state), idleContext->LocalVertices,
-                  idleContext->Frontier, graph.Vertices, 0, depth, mutex);
+        std::launch::async, [state, idleContext, &graph, &vertices, depth]() {
+          const Trace::Scope exploreScope("Explore");
+          const Allocations::Scope allocationScope(
+              Allocations::Subsystem::StateGraph);
+
+          // Another thread may have reached the state since it was queued
+          const auto [vertex, claimed] = vertices.Claim(state);
+          if (claimed) {
+            Explore(state, vertex, vertices, graph, idleContext->Frontier, 0,
+                    depth);
+          }
+
+          // The thread ends here, so its block goes to the next thread
+          graph.Objects->Detach();
         });
-  } while (!frontier.empty() || anyThreadActive());
+  }
 
+  vertices.Release();
   Strategies::RetrogradeAnalyse(graph);
 }
 
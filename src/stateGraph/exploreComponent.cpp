@@ -1,5 +1,8 @@
 #include <cassert>
 
+#include "../util/allocations.h"
+#include "../util/progress.h"
+#include "../util/trace.h"
 #include "strategies.h"
 
 namespace StateGraph {
@@ -7,52 +10,70 @@ namespace Strategies {
 
 static void ExploreComponentRecursive(
     std::shared_ptr<Vertex> vertex,
-    std::unordered_set<Game::Game, Hash, EqualTo>& exploring,
     std::unordered_set<std::shared_ptr<Vertex>>& frontier, const size_t depth,
     const size_t maxDepth, Graph& graph,
-    std::optional<SaveParameters>& saveParameters) {
+    std::optional<SaveParameters>& saveParameters,
+    const std::function<bool()>& shouldStop) {
+  // Stopping here leaves every vertex either fully expanded or not at all
+  if (shouldStop && shouldStop()) return;
+
   const Game::Game game = Game::Game::FromSerialization(vertex->Serialization);
-  exploring.insert(game);
   frontier.erase(vertex);
 
   for (Game::Move move : game.GetValidMoves()) {
     Game::Game nextState = game;
     nextState.DoMove(move);
 
-    const std::shared_ptr<Vertex> nextVertex =
-        graph.Vertices.emplace(nextState, std::make_shared<Vertex>(nextState))
-            .first->second;
+    const std::shared_ptr<Vertex> nextVertex = graph.Insert(nextState).first;
     assert(EqualTo()(Game::Game::FromSerialization(nextVertex->Serialization),
                      nextState));
 
-    vertex->Edges.emplace_back(
-        std::make_shared<Edge>(vertex, nextVertex, move));
+    vertex->Edges.emplace_back(graph.MakeEdge(vertex, nextVertex, move));
+    Progress::Add(Progress::Current.Edges);
+    Progress::Set(Progress::Current.Vertices, graph.Vertices.size());
 
-    // Don't expand already expanded vertices
-    if (exploring.contains(nextState)) continue;
+    // Don't expand already expanded vertices, which have their edges. This
+    // includes the vertices being expanded further up, and those expanded by
+    // an earlier run the graph was loaded from.
+    if (!nextVertex->Edges.empty()) continue;
 
     if (maxDepth == 0 || depth + 1 <= maxDepth) {
-      ExploreComponentRecursive(nextVertex, exploring, frontier, depth + 1,
-                                maxDepth, graph, saveParameters);
+      ExploreComponentRecursive(nextVertex, frontier, depth + 1, maxDepth,
+                                graph, saveParameters, shouldStop);
     } else {
       frontier.insert(nextVertex);
     }
   }
+
+  Progress::Add(Progress::Current.Expansions);
+  Progress::Set(Progress::Current.Frontier, frontier.size());
 }
 
 void ExploreComponent(Graph& graph, Game::Game game, const size_t maxDepth,
-                      std::optional<SaveParameters> saveParameters) {
-  const std::shared_ptr<Vertex> root =
-      graph.Vertices.emplace(game, std::make_shared<Vertex>(game))
-          .first->second;
+                      std::optional<SaveParameters> saveParameters,
+                      const std::function<bool()>& shouldStop) {
+  const Trace::Scope scope("ExploreComponent");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+  const Progress::PhaseScope phase("exploring");
+  Progress::Set(Progress::Current.Edges, graph.GetEdgeCount());
+
+  graph.Insert(game);
 
-  std::unordered_set<Game::Game, Hash, EqualTo> exploring;
-  std::unordered_set<std::shared_ptr<Vertex>> frontier = {root};
+  // A graph saved by a run that was stopped early continues from the vertices
+  // that run left unexpanded
+  const std::vector<std::shared_ptr<Vertex>> unexpanded =
+      graph.GetUnexpanded(game);
+  std::unordered_set<std::shared_ptr<Vertex>> frontier(unexpanded.begin(),
+                                                       unexpanded.end());
 
   while (!frontier.empty()) {
+    if (shouldStop && shouldStop()) return;
+
+    const Trace::Scope exploreScope("Explore");
+
     const std::shared_ptr<Vertex> vertex = *frontier.begin();
-    ExploreComponentRecursive(vertex, exploring, frontier, 0, maxDepth, graph,
-                              saveParameters);
+    ExploreComponentRecursive(vertex, frontier, 0, maxDepth, graph,
+                              saveParameters, shouldStop);
   }
 }
 
@@ -1,5 +1,8 @@
 #include <cassert>
 
+#include "../util/allocations.h"
+#include "../util/progress.h"
+#include "../util/trace.h"
 #include "strategies.h"
 
 namespace StateGraph {
@@ -19,22 +22,27 @@ static std::optional<WinState> Expand(
     const std::shared_ptr<Vertex> vertex, Graph& graph,
     std::unordered_set<std::shared_ptr<Vertex>>& expandingVertices,
     const std::shared_ptr<const Vertex> root,
-    std::optional<SaveParameters>& saveParameters) {
+    std::optional<SaveParameters>& saveParameters,
+    const std::function<bool()>& shouldStop, size_t& expansionCount) {
+  if (shouldStop && shouldStop()) return vertex->Quality;
+
+  // Already solved, e.g. by an earlier analysis on the same graph
+  if (vertex->Quality.has_value()) return vertex->Quality;
+
   expandingVertices.insert(vertex);
+  Progress::Set(Progress::Current.Frontier, expandingVertices.size());
 
   // Insert edges
+  const size_t edgeCount = vertex->Edges.size();
   const Game::Game game = Game::Game::FromSerialization(vertex->Serialization);
   bool terminalStateFound = false;
   for (Game::Move move : game.GetValidMoves()) {
     Game::Game nextGame(game);
     nextGame.DoMove(move);
 
-    const auto [nextGameIt, inserted] =
-        graph.Vertices.emplace(nextGame, std::make_shared<Vertex>(nextGame));
-    const std::shared_ptr<Vertex> nextVertex = nextGameIt->second;
+    const auto [nextVertex, inserted] = graph.Insert(nextGame);
 
-    InsertUnique(std::make_shared<Edge>(vertex, nextVertex, move),
-                 vertex->Edges);
+    InsertUnique(graph.MakeEdge(vertex, nextVertex, move), vertex->Edges);
 
     if (inserted && nextVertex->Quality.has_value()) {
       // New terminal state found
@@ -46,6 +54,11 @@ static std::optional<WinState> Expand(
     }
   }
 
+  expansionCount++;
+  Progress::Add(Progress::Current.Expansions);
+  Progress::Add(Progress::Current.Edges, vertex->Edges.size() - edgeCount);
+  Progress::Set(Progress::Current.Vertices, graph.Vertices.size());
+
   if (terminalStateFound) {
     RetrogradeAnalyse(graph);
 
@@ -67,7 +80,8 @@ static std::optional<WinState> Expand(
 
     // Try to expand node if not already being expanded
     if (!expandingVertices.contains(target)) {
-      Expand(target, graph, expandingVertices, root, saveParameters);
+      Expand(target, graph, expandingVertices, root, saveParameters,
+             shouldStop, expansionCount);
 
       // If the current or root vertex has been coloured by retrograde analysis,
       // then early-exit
@@ -85,20 +99,29 @@ static std::optional<WinState> Expand(
   return vertex->Quality;
 }
 
-void ForwardRetrogradeAnalysis(Graph& graph, const Game::Game root,
-                               std::optional<SaveParameters> saveParameters) {
-  const std::shared_ptr<Vertex> rootVertex =
-      graph.Vertices.emplace(root, std::make_shared<Vertex>(root))
-          .first->second;
+size_t ForwardRetrogradeAnalysis(Graph& graph, const Game::Game root,
+                                 std::optional<SaveParameters> saveParameters,
+                                 const std::function<bool()>& shouldStop) {
+  const Trace::Scope scope("ForwardRetrogradeAnalysis");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+  const Progress::PhaseScope phase("forward retrograde analysis");
+  Progress::Set(Progress::Current.Edges, graph.GetEdgeCount());
 
-  if (rootVertex->Quality.has_value()) return;
+  const std::shared_ptr<Vertex> rootVertex = graph.Insert(root).first;
+
+  if (rootVertex->Quality.has_value()) return 0;
 
   if (saveParameters) saveParameters->StartTimers();
 
   std::unordered_set<std::shared_ptr<Vertex>> expandingVertices;
 
-  Expand(rootVertex, graph, expandingVertices, rootVertex, saveParameters);
+  size_t expansionCount = 0;
+  Expand(rootVertex, graph, expandingVertices, rootVertex, saveParameters,
+         shouldStop, expansionCount);
+  if (shouldStop && shouldStop()) return expansionCount;
+
   if (!rootVertex->Quality.has_value()) RetrogradeAnalyse(graph);
+  return expansionCount;
 }
 
 }  // namespace Strategies
@@ -0,0 +1,18 @@
+#include "memoryBudget.h"
+
+#include "../util/memory.h"
+
+namespace StateGraph {
+
+bool MemoryBudget::Exceeded() {
+  if (ExceededVal) return true;
+  if (Checks++ % MEMORY_CHECK_INTERVAL != 0) return false;
+
+  const std::optional<size_t> resident = Memory::GetResidentMemory();
+  ExceededVal = resident.has_value() &&
+                resident.value() >= Limit * MEMORY_LIMIT_MARGIN;
+
+  return ExceededVal;
+}
+
+}  // namespace StateGraph
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+namespace StateGraph {
+
+// The fraction of the memory limit at which a construction is stopped,
+// leaving room for the final checkpoint
+constexpr double MEMORY_LIMIT_MARGIN = 0.9;
+
+// Reading the resident memory is a system call, so it is only done once per
+// this many checks
+constexpr size_t MEMORY_CHECK_INTERVAL = 1024;
+
+// Tells a construction strategy when to stop, before the process outgrows the
+// memory it has been given
+class MemoryBudget {
+ public:
+  MemoryBudget(size_t limit) : Limit(limit) {}
+
+  // Whether the resident memory has come close to the limit. Once it has,
+  // keeps returning true.
+  bool Exceeded();
+
+  bool HasExceeded() const { return ExceededVal; }
+  size_t GetLimit() const { return Limit; }
+
+ private:
+  size_t Limit;
+
+  size_t Checks = 0;
+  bool ExceededVal = false;
+};
+
+}  // namespace StateGraph
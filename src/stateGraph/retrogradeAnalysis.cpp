@@ -1,6 +1,10 @@
 #include <cassert>
 #include <iostream>
 
+#include "../util/allocations.h"
+#include "../util/progress.h"
+#include "../util/stats.h"
+#include "../util/trace.h"
 #include "strategies.h"
 
 namespace StateGraph {
@@ -198,6 +202,9 @@ static void RemoveNotFullyExpanded(
 
 static void AssignDraws(
     std::unordered_set<std::shared_ptr<Vertex>>& unlabelledExpandedVertices) {
+  const Trace::Scope scope("AssignDraws");
+
+  const size_t unlabelledCount = unlabelledExpandedVertices.size();
   RemoveNotFullyExpanded(unlabelledExpandedVertices);
 
   const auto isDrawEdge =
@@ -209,6 +216,11 @@ static void AssignDraws(
                unlabelledExpandedVertices.contains(target);
       };
 
+  // Vertices that cannot reach a draw stay unlabelled
+  Progress::Add(Progress::Current.Labelled, unlabelledExpandedVertices.size());
+  Progress::Set(Progress::Current.Unlabelled,
+                unlabelledCount - unlabelledExpandedVertices.size());
+
   for (const std::shared_ptr<Vertex> vertex : unlabelledExpandedVertices) {
     const auto edgeIt =
         std::find_if(vertex->Edges.begin(), vertex->Edges.end(), isDrawEdge);
@@ -221,19 +233,35 @@ static void AssignDraws(
 }
 
 void RetrogradeAnalyse(Graph& graph) {
+  const Trace::Scope scope("RetrogradeAnalyse");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+  const Progress::PhaseScope phase("retrograde analysis");
+
   // Keep trying until an uneventful loop occurred
   bool edgeLabelled = false;
 
+  size_t labelledCount = 0;
   std::unordered_set<std::shared_ptr<Vertex>> unlabelledExpandedVertices;
   unlabelledExpandedVertices.reserve(graph.Vertices.size());
   for (auto& [_, vertex] : graph.Vertices) {
     if (!vertex->Quality.has_value() && !vertex->Edges.empty()) {
       unlabelledExpandedVertices.insert(vertex);
     }
+    labelledCount += vertex->Quality.has_value();
   }
 
+  Progress::Set(Progress::Current.Vertices, graph.Vertices.size());
+  Progress::Set(Progress::Current.Labelled, labelledCount);
+  Progress::Set(Progress::Current.Unlabelled,
+                unlabelledExpandedVertices.size());
+
   // Analyse wins and losses
   do {
+    const Trace::Scope sweepScope("Retrograde sweep");
+    const Progress::PhaseScope sweepPhase("retrograde sweep");
+    Progress::Set(Progress::Current.WorkTotal,
+                  unlabelledExpandedVertices.size());
+    Stats::Count(Stats::Current.RetrogradeSweeps);
     edgeLabelled = false;
 
     // Check all vertices
@@ -241,6 +269,7 @@ void RetrogradeAnalyse(Graph& graph) {
          vertexIt != unlabelledExpandedVertices.end();) {
       const std::shared_ptr<Vertex> vertex = *vertexIt;
       bool vertexErased = false;
+      Progress::Add(Progress::Current.WorkDone);
 
       // Check all edges
       for (auto edgeIt = vertex->Edges.begin(); edgeIt != vertex->Edges.end();
@@ -260,6 +289,10 @@ void RetrogradeAnalyse(Graph& graph) {
         if (vertex->Quality.has_value()) {
           vertexIt = unlabelledExpandedVertices.erase(vertexIt);
           vertexErased = true;
+
+          Progress::Add(Progress::Current.Labelled);
+          Progress::Set(Progress::Current.Unlabelled,
+                        unlabelledExpandedVertices.size());
           break;
         }
       }
@@ -273,5 +306,135 @@ void RetrogradeAnalyse(Graph& graph) {
   assert(VerifyCorrectness(graph));
 }
 
+// Labels the unlabelled, expanded vertices that can avoid losing as draws,
+// like the AssignDraws above
+static void AssignDraws(CsrGraph& graph) {
+  const Trace::Scope scope("AssignDraws");
+
+  const size_t vertexCount = graph.GetVertexCount();
+  std::vector<bool> drawable(vertexCount);
+  size_t unlabelledCount = 0;
+  for (VertexId vertex = 0; vertex < vertexCount; vertex++) {
+    drawable[vertex] = !graph.Qualities[vertex].has_value() &&
+                       graph.GetEdgesBegin(vertex) != graph.GetEdgesEnd(vertex);
+    unlabelledCount += drawable[vertex];
+  }
+
+  // Remove vertices with a successor that is neither labelled nor drawable
+  bool anyVertexRemoved = true;
+  while (anyVertexRemoved) {
+    anyVertexRemoved = false;
+
+    for (VertexId vertex = 0; vertex < vertexCount; vertex++) {
+      if (!drawable[vertex]) continue;
+
+      for (EdgeId edge = graph.GetEdgesBegin(vertex);
+           edge < graph.GetEdgesEnd(vertex); edge++) {
+        const VertexId target = graph.Targets[edge];
+        if (graph.Qualities[target].has_value() || drawable[target]) continue;
+
+        drawable[vertex] = false;
+        unlabelledCount--;
+        anyVertexRemoved = true;
+        break;
+      }
+    }
+  }
+
+  Progress::Add(Progress::Current.Labelled, unlabelledCount);
+
+  for (VertexId vertex = 0; vertex < vertexCount; vertex++) {
+    if (!drawable[vertex]) continue;
+
+    EdgeId edge = graph.GetEdgesBegin(vertex);
+    while (graph.Qualities[graph.Targets[edge]] != WinState::Draw &&
+           !drawable[graph.Targets[edge]]) {
+      edge++;
+      assert(edge < graph.GetEdgesEnd(vertex));
+    }
+
+    graph.SetOptimalEdge(vertex, edge);
+    graph.Qualities[vertex] = WinState::Draw;
+  }
+}
+
+void RetrogradeAnalyse(CsrGraph& graph) {
+  const Trace::Scope scope("RetrogradeAnalyse");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::StateGraph);
+  const Progress::PhaseScope phase("retrograde analysis");
+
+  const size_t vertexCount = graph.GetVertexCount();
+  const size_t edgeCount = graph.GetEdgeCount();
+
+  // The edges into each vertex, in compressed sparse row form as well
+  std::vector<EdgeId> predecessorOffsets(vertexCount + 1, 0);
+  for (const VertexId target : graph.Targets) predecessorOffsets[target + 1]++;
+  for (VertexId vertex = 0; vertex < vertexCount; vertex++)
+    predecessorOffsets[vertex + 1] += predecessorOffsets[vertex];
+
+  std::vector<VertexId> predecessorSources(edgeCount);
+  std::vector<EdgeId> predecessorEdges(edgeCount);
+  {
+    std::vector<EdgeId> slots(predecessorOffsets.begin(),
+                              predecessorOffsets.end() - 1);
+    for (VertexId source = 0; source < vertexCount; source++) {
+      for (EdgeId edge = graph.GetEdgesBegin(source);
+           edge < graph.GetEdgesEnd(source); edge++) {
+        const EdgeId slot = slots[graph.Targets[edge]]++;
+        predecessorSources[slot] = source;
+        predecessorEdges[slot] = edge;
+      }
+    }
+  }
+
+  // The unlabelled edges out of each vertex. A vertex whose last one leads
+  // to a win for the opponent is lost.
+  std::vector<uint32_t> unlabelledEdges(vertexCount, 0);
+  std::vector<VertexId> labelled;
+  for (VertexId vertex = 0; vertex < vertexCount; vertex++) {
+    for (EdgeId edge = graph.GetEdgesBegin(vertex);
+         edge < graph.GetEdgesEnd(vertex); edge++) {
+      unlabelledEdges[vertex] += graph.Labels[edge] == EdgeLabel::Unlabelled;
+    }
+
+    if (graph.Qualities[vertex].has_value()) labelled.push_back(vertex);
+  }
+
+  Progress::Set(Progress::Current.Vertices, vertexCount);
+  Progress::Set(Progress::Current.Labelled, labelled.size());
+
+  // Analyse wins and losses, working backwards from the labelled vertices
+  for (size_t next = 0; next < labelled.size(); next++) {
+    const VertexId target = labelled[next];
+    const WinState quality = graph.Qualities[target].value();
+
+    // Draws are only settled once all wins and losses are known
+    if (quality == WinState::Draw) continue;
+
+    for (EdgeId slot = predecessorOffsets[target];
+         slot < predecessorOffsets[target + 1]; slot++) {
+      const VertexId source = predecessorSources[slot];
+      const EdgeId edge = predecessorEdges[slot];
+      if (graph.Qualities[source].has_value()) continue;
+      if (graph.Labels[edge] != EdgeLabel::Unlabelled) continue;
+
+      if (quality == WinState::Lose) {
+        graph.Qualities[source] = WinState::Win;
+      } else {
+        graph.Labels[edge] = EdgeLabel::NotOptimal;
+        if (--unlabelledEdges[source] > 0) continue;
+
+        graph.Qualities[source] = WinState::Lose;
+      }
+
+      graph.SetOptimalEdge(source, edge);
+      labelled.push_back(source);
+      Progress::Add(Progress::Current.Labelled);
+    }
+  }
+
+  AssignDraws(graph);
+}
+
 }  // namespace Strategies
 }  // namespace StateGraph
@@ -3,7 +3,9 @@
 #include <fstream>
 #include <memory>
 
+#include "../util/allocations.h"
 #include "../util/parse.h"
+#include "../util/trace.h"
 
 namespace StateGraph {
 namespace SaveSystem {
@@ -273,6 +275,9 @@ void Graph::Save(const std::filesystem::path& path,
                  const size_t runtime) const {
   using namespace SaveSystem;
 
+  const Trace::Scope scope("Graph::Save");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::SaveSystem);
+
   std::cout << "Saving current state graph..." << std::endl;
 
   std::ofstream stream;
@@ -292,6 +297,9 @@ std::pair<Graph, std::chrono::duration<size_t>> Graph::Load(
     const std::filesystem::path& path) {
   using namespace SaveSystem;
 
+  const Trace::Scope scope("Graph::Load");
+  const Allocations::Scope allocationScope(Allocations::Subsystem::SaveSystem);
+
   if (!std::filesystem::is_regular_file(path)) {
     const std::string err =
         std::format("\"{}\" is not a regular file!", path.string());
@@ -319,7 +327,7 @@ std::pair<Graph, std::chrono::duration<size_t>> Graph::Load(
     Game::Game&& game = Game::Game::FromSerialization(vertex.Serialization);
     graph.Vertices.emplace(
         std::move(game),
-        std::make_shared<Vertex>(vertex.Serialization, vertex.Quality));
+        graph.MakeVertex(vertex.Serialization, vertex.Quality));
   }
 
   for (const VertexInfo vertexInfo : vertices) {
@@ -331,7 +339,7 @@ std::pair<Graph, std::chrono::duration<size_t>> Graph::Load(
       Game::Game&& destGame = Game::Game::FromSerialization(edgeInfo.Dest);
       std::shared_ptr<Vertex> destVertex = graph.Vertices.at(destGame);
 
-      vertex->Edges.emplace_back(std::make_shared<Edge>(
+      vertex->Edges.emplace_back(graph.MakeEdge(
           vertex, std::move(destVertex), edgeInfo.Move, edgeInfo.Optimal));
     }
   }
@@ -0,0 +1,86 @@
+#include "sizeEstimate.h"
+
+#include <cmath>
+#include <random>
+
+#include "../util/trace.h"
+
+namespace StateGraph {
+
+namespace {
+
+// Accumulates samples, to estimate their mean
+struct Accumulator {
+  double Sum = 0;
+  double SquaredSum = 0;
+
+  void Add(const double sample) {
+    Sum += sample;
+    SquaredSum += sample * sample;
+  }
+
+  Estimate Get(const size_t sampleCount) const {
+    const double mean = Sum / sampleCount;
+    if (sampleCount < 2) return {mean, 0};
+
+    const double variance = std::max(
+        0.0, (SquaredSum - Sum * mean) / (sampleCount - 1));
+    return {mean, std::sqrt(variance / sampleCount)};
+  }
+};
+
+}  // namespace
+
+SizeEstimate EstimateSize(const Game::Game& root, const size_t maxDepth,
+                          const size_t probeCount,
+                          const std::optional<uint32_t> seed) {
+  const Trace::Scope scope("EstimateSize");
+
+  std::random_device randomDevice;
+  std::mt19937 generator(seed ? seed.value() : randomDevice());
+
+  std::vector<Accumulator> depths(maxDepth + 1);
+  Accumulator vertices;
+  Accumulator edges;
+
+  for (size_t probe = 0; probe < probeCount; probe++) {
+    Game::Game game = root;
+    // The inverse of the probability of this probe's path
+    double weight = 1;
+    double probeVertices = 0;
+    double probeEdges = 0;
+
+    for (size_t depth = 0; depth <= maxDepth; depth++) {
+      depths[depth].Add(weight);
+      probeVertices += weight;
+
+      const std::vector<Game::Move>& moves = game.GetValidMoves();
+      if (moves.empty() || depth == maxDepth) {
+        // Later depths still take this probe's zero samples
+        for (size_t rest = depth + 1; rest <= maxDepth; rest++)
+          depths[rest].Add(0);
+        break;
+      }
+
+      probeEdges += weight * moves.size();
+
+      std::uniform_int_distribution<size_t> randomMove(0, moves.size() - 1);
+      const Game::Move move = moves[randomMove(generator)];
+      weight *= moves.size();
+      game.DoMove(move);
+    }
+
+    vertices.Add(probeVertices);
+    edges.Add(probeEdges);
+  }
+
+  SizeEstimate estimate;
+  for (const Accumulator& depth : depths)
+    estimate.Depths.push_back(depth.Get(probeCount));
+  estimate.Vertices = vertices.Get(probeCount);
+  estimate.Edges = edges.Get(probeCount);
+
+  return estimate;
+}
+
+}  // namespace StateGraph
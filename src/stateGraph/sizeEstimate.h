@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../game/game.h"
+
+namespace StateGraph {
+
+// The z-score of a two-sided 95% confidence interval
+constexpr double CONFIDENCE_Z = 1.96;
+
+// An estimate and the standard error of its mean
+struct Estimate {
+  double Mean = 0;
+  double Error = 0;
+
+  double GetLower() const { return std::max(0.0, Mean - CONFIDENCE_Z * Error); }
+  double GetUpper() const { return Mean + CONFIDENCE_Z * Error; }
+};
+
+struct SizeEstimate {
+  // The positions at each depth of the game tree
+  std::vector<Estimate> Depths;
+
+  Estimate Vertices;
+  Estimate Edges;
+};
+
+// Estimates the size of the game tree below `root`, up to `maxDepth` moves
+// deep, with Knuth's random-probe estimator: each probe plays random moves,
+// and counts the positions at each depth as the product of the branching
+// factors on its path. Transpositions and symmetries merge positions of the
+// tree into a single vertex, so the state graph is at most this large.
+SizeEstimate EstimateSize(const Game::Game& root, size_t maxDepth,
+                          size_t probeCount,
+                          std::optional<uint32_t> seed = std::nullopt);
+
+}  // namespace StateGraph
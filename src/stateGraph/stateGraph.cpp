@@ -5,6 +5,7 @@
 #include <iostream>
 
 #include "../util/base64.h"
+#include "../util/stats.h"
 
 namespace StateGraph {
 
@@ -108,6 +109,8 @@ Edge::Edge(std::weak_ptr<Vertex> source, std::weak_ptr<Vertex> target,
 
 bool EqualTo::operator()(const Game::Game& first,
                          const Game::Game& second) const noexcept {
+  Stats::Count(Stats::Current.EqualToCalls);
+
   if (!UseSymmetries) return first == second;
 
   if (first.GetSetAsideCard() != second.GetSetAsideCard()) return false;
@@ -138,6 +141,8 @@ bool EqualTo::operator()(const Game::Game& first,
 }
 
 size_t Hash::operator()(const Game::Game& game) const noexcept {
+  Stats::Count(Stats::Current.HashCalls);
+
   // Cards
   size_t hash = (size_t)game.GetSetAsideCard().Type;
 
@@ -164,11 +169,54 @@ size_t Hash::operator()(const Game::Game& game) const noexcept {
 
 std::optional<std::weak_ptr<const Vertex>> Graph::Get(
     const Game::Game& game) const {
-  const Game::GameSerialization serialization = game.Serialize();
-  return Vertices.contains(game) ? std::optional(Vertices.at(game))
-                                 : std::nullopt;
+  return Get(VertexTable::GetKey(game));
+};
+
+std::pair<std::shared_ptr<Vertex>, bool> Graph::Insert(
+    const Game::Game& game) {
+  const Game::PositionKey key = VertexTable::GetKey(game);
+
+  // Only create the vertex when needed, as the arena never gives it back
+  const VertexTable::iterator found = Vertices.find(key);
+  if (found != Vertices.end()) return {found->second, false};
+
+  return {Vertices.emplace(key, MakeVertex(game)).first->second, true};
+}
+
+std::optional<std::weak_ptr<const Vertex>> Graph::Get(
+    const Game::PositionKey& key) const {
+  const VertexTable::const_iterator found = Vertices.find(key);
+  return found != Vertices.end() ? std::optional(found->second) : std::nullopt;
 };
 
+std::vector<std::shared_ptr<Vertex>> Graph::GetUnexpanded(
+    const Game::Game& root) const {
+  const VertexTable::const_iterator found = Vertices.find(root);
+  if (found == Vertices.end()) return {};
+
+  std::vector<std::shared_ptr<Vertex>> unexpanded;
+  std::unordered_set<const Vertex*> visited = {found->second.get()};
+  std::vector<std::shared_ptr<Vertex>> stack = {found->second};
+  while (!stack.empty()) {
+    const std::shared_ptr<Vertex> vertex = std::move(stack.back());
+    stack.pop_back();
+
+    // Terminal vertices are labelled as they are created
+    if (vertex->Edges.empty()) {
+      if (!vertex->Quality.has_value()) unexpanded.push_back(vertex);
+      continue;
+    }
+
+    for (const std::shared_ptr<Edge>& edge : vertex->Edges) {
+      std::shared_ptr<Vertex> target = edge->Target.lock();
+      if (target != nullptr && visited.insert(target.get()).second)
+        stack.push_back(std::move(target));
+    }
+  }
+
+  return unexpanded;
+}
+
 static std::optional<Game::Move> ParseMove(std::istringstream& string) {
   // Pawn id
   std::string pawnIdString;
@@ -350,9 +398,9 @@ Graph Graph::Import(const std::filesystem::path& nodesPath,
     const std::optional<Vertex> vertex =
         ParseVertex(std::istringstream(nodeString));
     if (vertex) {
-      graph.Vertices.insert(
-          {Game::Game::FromSerialization(vertex->Serialization),
-           std::make_shared<Vertex>(vertex.value())});
+      graph.Vertices.emplace(
+          Game::Game::FromSerialization(vertex->Serialization),
+          graph.MakeVertex(vertex.value()));
     }
   }
 
@@ -370,7 +418,7 @@ Graph Graph::Import(const std::filesystem::path& nodesPath,
     if (!edge) continue;
 
     const std::shared_ptr<Vertex> source = edge->Source.lock();
-    source->Edges.emplace_back(std::make_shared<Edge>(edge.value()));
+    source->Edges.emplace_back(graph.MakeEdge(edge.value()));
   }
 
   edgesStream.close();
@@ -434,19 +482,99 @@ void Graph::ExportImages(const std::filesystem::path& imagesPath) const {
   std::cout << std::format("Exporting images: {}", imagesPath.string())
             << std::endl;
 
-  for (const auto [game, vertex] : Vertices) {
-    game.ExportImage(imagesPath);
+  for (const auto& [_, vertex] : Vertices) {
+    Game::Game::FromSerialization(vertex->Serialization)
+        .ExportImage(imagesPath);
+  }
+}
+
+// The control block allocate_shared places alongside each object, which
+// holds a copy of the allocator
+constexpr size_t SHARED_OVERHEAD =
+    2 * sizeof(void*) + 2 * sizeof(int) + sizeof(ArenaAllocator<Vertex>);
+// The pair and next pointer of each node of an unordered container
+constexpr size_t NODE_OVERHEAD = sizeof(void*) + sizeof(size_t);
+
+// Splits the arena blocks between the vertices and edges allocated from them
+static void SplitObjects(MemoryUsage& usage, const size_t reservedBytes,
+                         const size_t vertexCount, const size_t edgeCount) {
+  const double vertexBytes =
+      (double)vertexCount * (sizeof(Vertex) + SHARED_OVERHEAD);
+  const double edgeBytes = (double)edgeCount * (sizeof(Edge) + SHARED_OVERHEAD);
+  if (vertexBytes + edgeBytes == 0.0) {
+    usage.VertexObjects = reservedBytes;
+    return;
+  }
+
+  usage.VertexObjects =
+      (size_t)(reservedBytes * (vertexBytes / (vertexBytes + edgeBytes)));
+  usage.EdgeObjects = reservedBytes - usage.VertexObjects;
+}
+
+Graph& Graph::operator=(const Graph& other) {
+  if (this == &other) return *this;
+
+  Vertices.clear();
+  Objects = other.Objects;
+  Vertices = other.Vertices;
+  return *this;
+}
+
+Graph& Graph::operator=(Graph&& other) {
+  if (this == &other) return *this;
+
+  Vertices.clear();
+  Objects = std::move(other.Objects);
+  Vertices = std::move(other.Vertices);
+  return *this;
+}
+
+MemoryUsage Graph::GetMemoryUsage(const size_t frontierSize) const {
+  MemoryUsage usage;
+  size_t edgeCount = 0;
+  for (const auto& [_, vertex] : Vertices) {
+    usage.EdgeLists +=
+        vertex->Edges.capacity() * sizeof(std::shared_ptr<Edge>);
+    edgeCount += vertex->Edges.size();
+  }
+  SplitObjects(usage, Objects->GetReservedBytes(), Vertices.size(),
+               edgeCount);
+
+  usage.Keys = Vertices.GetHeapSize();
+
+  // The frontier sets are node-based and hold full games, assumed to be the
+  // size of the root's
+  if (!Vertices.empty()) {
+    const Game::Game game =
+        Game::Game::FromSerialization(Vertices.begin()->second->Serialization);
+    usage.Frontier = frontierSize * (sizeof(Game::Game) + NODE_OVERHEAD +
+                                     game.GetHeapSize() + sizeof(void*));
   }
+
+  return usage;
+}
+
+MemoryUsage Graph::EstimateMemoryUsage(const size_t vertexCount,
+                                       const size_t edgeCount) {
+  // The arena takes whole blocks from the system, and each edge is pointed to
+  // by its source vertex
+  const size_t objectBytes = vertexCount * (sizeof(Vertex) + SHARED_OVERHEAD) +
+                             edgeCount * (sizeof(Edge) + SHARED_OVERHEAD);
+  MemoryUsage usage{
+      .EdgeLists = edgeCount * sizeof(std::shared_ptr<Edge>),
+      .Keys = VertexTable::EstimateHeapSize(vertexCount),
+  };
+  SplitObjects(usage,
+               (objectBytes + ARENA_BLOCK_SIZE - 1) / ARENA_BLOCK_SIZE *
+                   ARENA_BLOCK_SIZE,
+               vertexCount, edgeCount);
+
+  return usage;
 }
 
 size_t Graph::GetEdgeCount() const {
   size_t count = 0;
-
-  std::for_each(
-      Vertices.begin(), Vertices.end(),
-      [&count](std::pair<Game::Game, std::shared_ptr<const Vertex>> vertex) {
-        count += vertex.second->Edges.size();
-      });
+  for (const auto& [_, vertex] : Vertices) count += vertex->Edges.size();
 
   return count;
 }
@@ -8,6 +8,8 @@
 
 #include "../game/game.h"
 #include "../util/winState.h"
+#include "arena.h"
+#include "vertexTable.h"
 
 namespace StateGraph {
 
@@ -62,9 +64,37 @@ struct EqualTo {
                   const Game::Game& second) const noexcept;
 };
 
+// An estimate of the memory held by each part of a graph, in bytes
+struct MemoryUsage {
+  // The arena blocks holding the vertices and edges, split between them by
+  // the share of the blocks their objects take up
+  size_t VertexObjects = 0;
+  size_t EdgeObjects = 0;
+  // The lists of edge pointers of the vertices
+  size_t EdgeLists = 0;
+  // The slots of the vertex table, holding the keys and vertex pointers
+  size_t Keys = 0;
+  // The frontier sets of the construction strategies
+  size_t Frontier = 0;
+
+  size_t GetTotal() const {
+    return VertexObjects + EdgeObjects + EdgeLists + Keys + Frontier;
+  }
+};
+
 struct Graph {
  public:
+  Graph() = default;
+  Graph(const Graph& other) = default;
+  Graph(Graph&& other) = default;
+  // Release the vertices before the arena they live in, which the defaulted
+  // operators would replace first
+  Graph& operator=(const Graph& other);
+  Graph& operator=(Graph&& other);
+
   std::optional<std::weak_ptr<const Vertex>> Get(const Game::Game& game) const;
+  std::optional<std::weak_ptr<const Vertex>> Get(
+      const Game::PositionKey& key) const;
 
   void Save(const std::filesystem::path& path, size_t runtime = 0) const;
   static std::pair<Graph, std::chrono::duration<size_t>> Load(
@@ -79,8 +109,43 @@ struct Graph {
   size_t GetNodeCount() const { return Vertices.size(); }
   size_t GetEdgeCount() const;
 
-  std::unordered_map<Game::Game, std::shared_ptr<Vertex>, Hash, EqualTo>
-      Vertices;
+  // Estimates the memory held by the graph, with `frontierSize` games in the
+  // frontier of the construction strategy
+  MemoryUsage GetMemoryUsage(size_t frontierSize = 0) const;
+  // Estimates the memory a graph of this many vertices and edges would hold
+  static MemoryUsage EstimateMemoryUsage(size_t vertexCount, size_t edgeCount);
+
+  // Makes room for `vertexCount` vertices, so that the vertex table need not
+  // rehash while the graph is constructed
+  void Reserve(size_t vertexCount) { Vertices.reserve(vertexCount); }
+
+  // Finds the vertex of `game`, creating it if there is none yet. Returns the
+  // vertex, and whether it was created.
+  std::pair<std::shared_ptr<Vertex>, bool> Insert(const Game::Game& game);
+
+  // The vertices reachable from that of `root` which have not been expanded
+  // yet, such as those a construction strategy stopped early leaves behind.
+  // Empty if `root` has no vertex.
+  std::vector<std::shared_ptr<Vertex>> GetUnexpanded(
+      const Game::Game& root) const;
+
+  // Creates a vertex or edge in the arena of the graph, which it must not
+  // outlive
+  template <class... Args>
+  std::shared_ptr<Vertex> MakeVertex(Args&&... args) {
+    return std::allocate_shared<Vertex>(ArenaAllocator<Vertex>(Objects.get()),
+                                        std::forward<Args>(args)...);
+  }
+  template <class... Args>
+  std::shared_ptr<Edge> MakeEdge(Args&&... args) {
+    return std::allocate_shared<Edge>(ArenaAllocator<Edge>(Objects.get()),
+                                      std::forward<Args>(args)...);
+  }
+
+  // Shared by copies of the graph, and declared before the vertices so that
+  // it outlives them
+  std::shared_ptr<Arena> Objects = std::make_shared<Arena>();
+  VertexTable Vertices;
 
  private:
   std::optional<Edge> ParseEdge(std::istringstream string) const;
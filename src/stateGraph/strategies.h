@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+
+#include "csrGraph.h"
 #include "saveSystem.h"
 #include "stateGraph.h"
 
@@ -11,18 +14,30 @@ using namespace SaveSystem;
 void RetrogradeAnalyse(std::shared_ptr<Vertex> source, WinState targetQuality,
                        std::shared_ptr<Edge> edge);
 void RetrogradeAnalyse(Graph& graph);
+// Labels the same vertices as the above. Works backwards from each labelled
+// vertex through a reverse index of the edges, instead of sweeping the graph
+// until nothing changes.
+void RetrogradeAnalyse(CsrGraph& graph);
 
+// Stops early, leaving vertices unexpanded, once `shouldStop` returns true
 void ExploreComponent(
     Graph& graph, Game::Game root, size_t maxDepth,
-    std::optional<SaveParameters> saveParameters = std::nullopt);
+    std::optional<SaveParameters> saveParameters = std::nullopt,
+    const std::function<bool()>& shouldStop = nullptr);
 
-void ForwardRetrogradeAnalysis(
+// Stops early, leaving the root unsolved, once `shouldStop` returns true.
+// Returns the number of vertices this call expanded, which other users of the
+// same graph do not add to.
+size_t ForwardRetrogradeAnalysis(
     Graph& graph, Game::Game root,
-    std::optional<SaveParameters> saveParameters = std::nullopt);
+    std::optional<SaveParameters> saveParameters = std::nullopt,
+    const std::function<bool()>& shouldStop = nullptr);
 
+// Stops early, without analysing the graph, once `shouldStop` returns true
 void DispersedFrontier(
     Graph& graph, Game::Game root, size_t frontier, size_t maxThreadCount,
-    std::optional<SaveParameters> saveParameters = std::nullopt);
+    std::optional<SaveParameters> saveParameters = std::nullopt,
+    const std::function<bool()>& shouldStop = nullptr);
 
 }  // namespace Strategies
 }  // namespace StateGraph
@@ -0,0 +1,243 @@
+#include "vertexTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <stdexcept>
+
+#include "stateGraph.h"
+
+namespace StateGraph {
+
+constexpr size_t MIN_CAPACITY = 16;
+// Beyond this fraction of occupied slots, probe sequences grow long
+constexpr size_t MAX_LOAD_NUMERATOR = 4;
+constexpr size_t MAX_LOAD_DENOMINATOR = 5;
+
+constexpr size_t SLOT_SIZE = sizeof(VertexTable::Entry) + sizeof(uint8_t);
+
+static void AddBits(Game::GameSerialization& serialization, const size_t bits,
+                    size_t& size, const size_t bitsSize) {
+  serialization |= Game::GameSerialization(bits) << size;
+  size += bitsSize;
+}
+
+Game::PositionKey VertexTable::GetKey(const Game::Game& game) {
+  // Lay the key out like Game::Serialize. With symmetries, the board is
+  // turned as if the current player were the top player.
+  const auto [width, height] = game.GetDimensions();
+  const size_t boardEnd = width * height - 1;
+  const Color current = game.GetCurrentPlayer();
+  const bool orient = UseSymmetries && current != TopPlayer;
+  const Color top = orient ? current : TopPlayer;
+
+  Game::GameSerialization serialization;
+  size_t size = 0;
+
+  // Current player
+  AddBits(serialization, current == top, size, 1);
+
+  // Card distribution, with the hands sorted
+  constexpr size_t cardSize =
+      std::bit_width((size_t)Game::CardType::CardTypeCount - 1);
+  AddBits(serialization, (size_t)game.GetSetAsideCard().Type, size, cardSize);
+  for (const Color player : {top, ~top}) {
+    const std::span<const Game::Card, HAND_SIZE> hand = game.GetHand(player);
+    const auto [first, second] =
+        std::minmax({(size_t)hand[0].Type, (size_t)hand[1].Type});
+    AddBits(serialization, first, size, cardSize);
+    AddBits(serialization, second, size, cardSize);
+  }
+
+  // Board dimensions
+  constexpr size_t dimensionSize = std::bit_width(MAX_DIMENSION);
+  AddBits(serialization, width, size, dimensionSize);
+  AddBits(serialization, height, size, dimensionSize);
+
+  // Pawn locations, turned with the board so that they stay sorted
+  constexpr size_t captured = MAX_DIMENSION * MAX_DIMENSION;
+  constexpr size_t coordinateSize = std::bit_width(captured);
+  const auto addPawn = [&](const Coordinate coordinate) {
+    const size_t offset = coordinate.x + coordinate.y * width;
+    AddBits(serialization, orient ? boardEnd - offset : offset, size,
+            coordinateSize);
+  };
+
+  for (const Color player : {top, ~top}) {
+    const bool masterCaptured = game.MasterCaptured(player);
+    const std::vector<Coordinate>& locations = game.GetPawnCoordinates(player);
+
+    if (masterCaptured) {
+      AddBits(serialization, captured, size, coordinateSize);
+    } else {
+      addPawn(locations[0]);
+    }
+
+    const size_t studentsBegin = !masterCaptured;
+    if (orient) {
+      for (size_t i = locations.size(); i > studentsBegin; i--)
+        addPawn(locations[i - 1]);
+    } else {
+      for (size_t i = studentsBegin; i < locations.size(); i++)
+        addPawn(locations[i]);
+    }
+
+    for (size_t i = locations.size() + masterCaptured; i < width; i++) {
+      AddBits(serialization, captured, size, coordinateSize);
+    }
+  }
+
+  return Game::PositionKey::FromSerialization(serialization);
+}
+
+uint64_t VertexTable::Hash(const Game::PositionKey& key) {
+  uint64_t hash = key.Low ^ (key.High * 0x9E3779B97F4A7C15);
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCD;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
+size_t VertexTable::GetHome(const Game::PositionKey& key) const {
+  Stats::Count(Stats::Current.HashCalls);
+  return Hash(key) & (capacity() - 1);
+}
+
+size_t VertexTable::FindSlot(const Game::PositionKey& key) const {
+  if (Size == 0) return capacity();
+
+  const size_t mask = capacity() - 1;
+  size_t slot = GetHome(key);
+  for (size_t distance = 1; (Distances[slot] & DISTANCE_MASK) >= distance;
+       distance++) {
+    Stats::Count(Stats::Current.EqualToCalls);
+    if (Entries[slot].first == key) return slot;
+
+    slot = (slot + 1) & mask;
+  }
+
+  // Any entry of this key would have displaced the poorer entry found here
+  return capacity();
+}
+
+VertexTable::iterator VertexTable::find(const Game::PositionKey& key) {
+  return iterator(this, FindSlot(key));
+}
+
+VertexTable::const_iterator VertexTable::find(
+    const Game::PositionKey& key) const {
+  return const_iterator(this, FindSlot(key));
+}
+
+const std::shared_ptr<Vertex>& VertexTable::at(
+    const Game::PositionKey& key) const {
+  const size_t slot = FindSlot(key);
+  if (slot == capacity()) throw std::out_of_range("Vertex not in table!");
+
+  return Entries[slot].second;
+}
+
+std::pair<VertexTable::iterator, bool> VertexTable::emplace(
+    const Game::PositionKey& key, std::shared_ptr<Vertex> vertex) {
+  const size_t found = FindSlot(key);
+  if (found != capacity()) return {iterator(this, found), false};
+
+  if ((Size + 1) * MAX_LOAD_DENOMINATOR > capacity() * MAX_LOAD_NUMERATOR)
+    Rehash(std::max(MIN_CAPACITY, capacity() * 2));
+
+  const size_t slot = Insert({key, std::move(vertex)});
+  return {iterator(this, slot), true};
+}
+
+size_t VertexTable::Insert(Entry entry, uint8_t flag) {
+  const Game::PositionKey key = entry.first;
+  const size_t mask = capacity() - 1;
+
+  std::optional<size_t> placed;
+  size_t slot = GetHome(key);
+  for (size_t distance = 1;; distance++) {
+    // Should a hash cluster exhaust the distances, spread it out
+    if (distance > DISTANCE_MASK) {
+      Rehash(capacity() * 2);
+      Insert(std::move(entry), flag);
+      return FindSlot(key);
+    }
+
+    const size_t slotDistance = Distances[slot] & DISTANCE_MASK;
+    if (slotDistance == 0) {
+      Entries[slot] = std::move(entry);
+      Distances[slot] = distance | flag;
+      Size++;
+      return placed.value_or(slot);
+    }
+
+    // Take the slot from entries closer to their home, carrying them on
+    if (slotDistance < distance) {
+      std::swap(Entries[slot], entry);
+      const uint8_t displacedFlag = Distances[slot] & FLAG;
+      Distances[slot] = distance | flag;
+      distance = slotDistance;
+      flag = displacedFlag;
+      if (!placed) placed = slot;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+}
+
+void VertexTable::Rehash(const size_t newCapacity) {
+  assert(std::has_single_bit(newCapacity) && newCapacity >= Size);
+
+  std::vector<Entry> entries(newCapacity);
+  std::vector<uint8_t> distances(newCapacity, 0);
+  std::swap(Entries, entries);
+  std::swap(Distances, distances);
+  Size = 0;
+
+  for (size_t slot = 0; slot < distances.size(); slot++) {
+    if ((distances[slot] & DISTANCE_MASK) != 0)
+      Insert(std::move(entries[slot]), distances[slot] & FLAG);
+  }
+}
+
+static size_t GetCapacity(const size_t count) {
+  const size_t slots =
+      (count * MAX_LOAD_DENOMINATOR + MAX_LOAD_NUMERATOR - 1) /
+      MAX_LOAD_NUMERATOR;
+  return std::max(MIN_CAPACITY, std::bit_ceil(slots));
+}
+
+void VertexTable::reserve(const size_t count) {
+  const size_t newCapacity = GetCapacity(count);
+  if (newCapacity > capacity()) Rehash(newCapacity);
+}
+
+void VertexTable::clear() {
+  Entries.clear();
+  Entries.shrink_to_fit();
+  Distances.clear();
+  Distances.shrink_to_fit();
+  Size = 0;
+}
+
+size_t VertexTable::GetHeapSize() const { return capacity() * SLOT_SIZE; }
+
+size_t VertexTable::EstimateHeapSize(const size_t count) {
+  return GetCapacity(count) * SLOT_SIZE;
+}
+
+Stats::TableStats VertexTable::GetStats() const {
+  Stats::TableStats stats{.Size = Size, .Capacity = capacity()};
+  for (const uint8_t distance : Distances) {
+    if ((distance & DISTANCE_MASK) == 0) continue;
+
+    const size_t probeLength = (distance & DISTANCE_MASK) - 1;
+    stats.MaxProbeLength = std::max(stats.MaxProbeLength, probeLength);
+    stats.ProbeHistogram[probeLength]++;
+  }
+
+  return stats;
+}
+
+}  // namespace StateGraph
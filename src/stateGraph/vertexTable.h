@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../game/game.h"
+#include "../util/stats.h"
+
+namespace StateGraph {
+
+struct Vertex;
+
+// The vertices of a state graph, keyed by the packed canonical form of their
+// game. Entries are stored inline in one open-addressing table with Robin Hood
+// probing, so that a lookup hashes two words and scans neighbouring slots
+// rather than chasing node pointers, and an entry takes 33 bytes rather than
+// a node holding a full game. Each entry also carries a flag, free for the
+// owner of the table to use.
+class VertexTable {
+ public:
+  typedef std::pair<Game::PositionKey, std::shared_ptr<Vertex>> Entry;
+
+  template <bool Const>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+    using reference = std::conditional_t<Const, const Entry&, Entry&>;
+    using Table = std::conditional_t<Const, const VertexTable, VertexTable>;
+
+    Iterator() = default;
+    Iterator(Table* table, const size_t slot) : Owner(table), Slot(slot) {
+      SkipEmpty();
+    }
+    // Allows converting mutable iterators to constant ones
+    template <bool OtherConst>
+      requires(Const && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other)
+        : Owner(other.Owner), Slot(other.Slot) {}
+
+    reference operator*() const { return Owner->Entries[Slot]; }
+    pointer operator->() const { return &Owner->Entries[Slot]; }
+
+    Iterator& operator++() {
+      Slot++;
+      SkipEmpty();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const { return Slot == other.Slot; }
+
+   private:
+    friend class Iterator<true>;
+    friend class VertexTable;
+
+    void SkipEmpty() {
+      while (Slot < Owner->Distances.size() &&
+             (Owner->Distances[Slot] & DISTANCE_MASK) == 0)
+        Slot++;
+    }
+
+    Table* Owner = nullptr;
+    size_t Slot = 0;
+  };
+
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+
+  // Packs `game` into the key of its vertex, so that the games EqualTo
+  // considers equal get the same key: the cards in each hand are sorted and,
+  // with symmetries, the board is seen from the current player.
+  static Game::PositionKey GetKey(const Game::Game& game);
+  // Mixes both words of `key`, as its low bits vary little between games
+  static uint64_t Hash(const Game::PositionKey& key);
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, Distances.size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, Distances.size()); }
+
+  size_t size() const { return Size; }
+  bool empty() const { return Size == 0; }
+  size_t capacity() const { return Distances.size(); }
+
+  iterator find(const Game::PositionKey& key);
+  const_iterator find(const Game::PositionKey& key) const;
+  iterator find(const Game::Game& game) { return find(GetKey(game)); }
+  const_iterator find(const Game::Game& game) const {
+    return find(GetKey(game));
+  }
+
+  bool contains(const Game::PositionKey& key) const {
+    return find(key) != end();
+  }
+  bool contains(const Game::Game& game) const { return contains(GetKey(game)); }
+
+  // Throws std::out_of_range if there is no such vertex
+  const std::shared_ptr<Vertex>& at(const Game::PositionKey& key) const;
+  const std::shared_ptr<Vertex>& at(const Game::Game& game) const {
+    return at(GetKey(game));
+  }
+
+  // Inserts `vertex` if no vertex has this key yet. Returns the entry of the
+  // key, and whether it was inserted.
+  std::pair<iterator, bool> emplace(const Game::PositionKey& key,
+                                    std::shared_ptr<Vertex> vertex);
+  std::pair<iterator, bool> emplace(const Game::Game& game,
+                                    std::shared_ptr<Vertex> vertex) {
+    return emplace(GetKey(game), std::move(vertex));
+  }
+
+  bool GetFlag(const const_iterator entry) const {
+    return Distances[entry.Slot] & FLAG;
+  }
+  void SetFlag(const iterator entry, const bool flag) {
+    Distances[entry.Slot] = (Distances[entry.Slot] & DISTANCE_MASK) |
+                            (flag ? FLAG : uint8_t{0});
+  }
+
+  // Makes room for `count` vertices without growing
+  void reserve(size_t count);
+  void clear();
+
+  // The bytes the table has allocated on the heap, not counting the vertices
+  size_t GetHeapSize() const;
+  // The bytes a table holding `count` vertices would allocate
+  static size_t EstimateHeapSize(size_t count);
+
+  // The probe lengths of the entries, whose long tail betrays a weak hash
+  Stats::TableStats GetStats() const;
+
+ private:
+  size_t GetHome(const Game::PositionKey& key) const;
+  // Returns the slot of `key`, or the capacity if it is absent
+  size_t FindSlot(const Game::PositionKey& key) const;
+  // Places an entry whose key is absent, and returns the slot it ends up in
+  size_t Insert(Entry entry, uint8_t flag = 0);
+  void Rehash(size_t capacity);
+
+  static constexpr uint8_t DISTANCE_MASK = 0x7F;
+  static constexpr uint8_t FLAG = 0x80;
+
+  std::vector<Entry> Entries;
+  // The distance of each entry from its home slot plus one, or 0 if empty, in
+  // the low bits, and the flag of the entry in the high bit
+  std::vector<uint8_t> Distances;
+  size_t Size = 0;
+};
+
+}  // namespace StateGraph
@@ -0,0 +1,27 @@
+#include "databaseLookup.h"
+
+namespace Strategy {
+
+DatabaseLookup::DatabaseLookup(std::unique_ptr<Strategy> strategy,
+                               PositionDatabase::Database&& database,
+                               const size_t minVisits)
+    : Inner(std::move(strategy)),
+      Database(std::move(database)),
+      MinVisits(minVisits) {}
+
+Game::Move DatabaseLookup::GetMove(const Game::Game& game,
+                                   const SearchLimits& limits) {
+  const std::optional<Game::Move> move =
+      Database.Find(game).GetBestMove(MinVisits);
+
+  // Guard against a database file that has been corrupted
+  if (move && game.IsValidMove(move.value())) {
+    HitCount++;
+    return move.value();
+  }
+
+  MissCount++;
+  return Inner->GetMove(game, limits);
+}
+
+}  // namespace Strategy
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+
+#include "../positionDatabase/positionDatabase.h"
+#include "strategy.h"
+
+namespace Strategy {
+
+// Wraps a strategy, and plays the best known move from a position database
+// instead wherever the position has been visited often enough
+class DatabaseLookup : public Strategy {
+ public:
+  DatabaseLookup(std::unique_ptr<Strategy> strategy,
+                 PositionDatabase::Database&& database,
+                 const size_t minVisits);
+
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
+
+  void Ponder(const Game::Game& game) override { Inner->Ponder(game); }
+  void StopPondering() override { Inner->StopPondering(); }
+
+  bool SupportsPondering() const override {
+    return Inner->SupportsPondering();
+  }
+
+  size_t GetNodeCount() const override { return Inner->GetNodeCount(); }
+
+  size_t GetHitCount() const { return HitCount; }
+  size_t GetMissCount() const { return MissCount; }
+
+ private:
+  std::unique_ptr<Strategy> Inner;
+
+  PositionDatabase::Database Database;
+  size_t MinVisits;
+
+  size_t HitCount = 0;
+  size_t MissCount = 0;
+};
+
+}  // namespace Strategy
@@ -7,7 +7,8 @@
 
 namespace Strategy {
 
-Game::Move Human::GetMove(const Game::Game& game) {
+Game::Move Human::GetMove(const Game::Game& game,
+                          const SearchLimits& limits) {
   std::optional<Game::Move> move;
 
   if (game.HasValidMoves()) {
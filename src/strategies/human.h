@@ -12,7 +12,10 @@ namespace Strategy {
 
 class Human : public Strategy {
  public:
-  Game::Move GetMove(const Game::Game& game) override;
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
+
+  bool SupportsPondering() const override { return false; }
 
   static std::optional<std::function<std::unique_ptr<Human>()>> Parse(
       std::istringstream& stream);
@@ -12,19 +12,47 @@ namespace Strategy {
 MinMax::MinMax(const std::optional<const size_t> maxDepth)
     : MaxDepth(maxDepth) {}
 
-Game::Move MinMax::GetMove(const Game::Game& game) {
+Game::Move MinMax::GetMove(const Game::Game& game,
+                           const SearchLimits& limits) {
+  if (!limits.Deadline && !limits.StopToken.stop_possible())
+    return Search(game, MaxDepth, limits).first;
+
+  // Deepen one ply at a time, so that the search the deadline cuts off can be
+  // dropped in favour of the last one that completed
+  Game::Move bestMove = game.GetValidMoves()[0];
+  for (size_t depth = 1; !MaxDepth || depth <= MaxDepth.value(); depth++) {
+    const auto [move, value] = Search(game, depth, limits);
+    if (limits.Expired()) break;
+
+    bestMove = move;
+
+    // Only moves that were cut off at this depth can change value deeper down
+    if (value != WinState::Draw) break;
+  }
+
+  return bestMove;
+}
+
+std::pair<Game::Move, WinState> MinMax::Search(
+    const Game::Game& game, const std::optional<size_t> maxDepth,
+    const SearchLimits& limits) {
   const std::vector<Game::Move>& moves = game.GetValidMoves();
 
   std::vector<std::pair<Game::Move, std::future<WinState>>> futures;
   futures.reserve(moves.size());
 
-  for (Game::Move move : moves) {
+  // Counted per thread, and summed once all threads are done
+  std::vector<size_t> nodeCounts(moves.size(), 0);
+
+  for (size_t moveId = 0; moveId < moves.size(); moveId++) {
     Game::Game nextState = Game::Game(game);
-    nextState.DoMove(move);
+    nextState.DoMove(moves[moveId]);
 
     futures.emplace_back(
-        move, std::async(std::launch::async, &MinMax::PlayRecursive, this,
-                         std::move(nextState), 0));
+        moves[moveId],
+        std::async(std::launch::async, &MinMax::PlayRecursive, this,
+                   std::move(nextState), 0, maxDepth, std::cref(limits),
+                   std::ref(nodeCounts[moveId])));
   }
 
   WinState bestMoveValue = WinState::Lose;
@@ -39,11 +67,20 @@ Game::Move MinMax::GetMove(const Game::Game& game) {
     }
   }
 
-  return bestMove;
+  for (const size_t nodeCount : nodeCounts) NodeCount += nodeCount;
+
+  return {bestMove, bestMoveValue};
 }
 
-WinState MinMax::PlayRecursive(Game::Game game, const size_t depth) const {
-  if (depth == MaxDepth) return WinState::Draw;
+WinState MinMax::PlayRecursive(Game::Game game, const size_t depth,
+                               const std::optional<size_t> maxDepth,
+                               const SearchLimits& limits,
+                               size_t& nodeCount) const {
+  nodeCount++;
+
+  // Out of time: treat the unexplored subtree as undecided. GetMove drops the
+  // search this happens in.
+  if (depth == maxDepth || limits.Expired()) return WinState::Draw;
 
   const std::optional<Color> winner = game.IsFinished();
   if (winner) {
@@ -58,7 +95,10 @@ WinState MinMax::PlayRecursive(Game::Game game, const size_t depth) const {
     Game::Game nextState = Game::Game(game);
     nextState.DoMove(move);
 
-    best = std::max(-PlayRecursive(std::move(nextState), depth + 1), best);
+    best = std::max(
+        -PlayRecursive(std::move(nextState), depth + 1, maxDepth, limits,
+                       nodeCount),
+        best);
   }
 
   return best;
@@ -12,7 +12,8 @@ class MinMax : public Strategy {
  public:
   MinMax(const std::optional<const size_t> maxDepth);
 
-  Game::Move GetMove(const Game::Game& game) override;
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
 
   static std::optional<std::function<std::unique_ptr<MinMax>()>> Parse(
       std::istringstream& stream);
@@ -29,7 +30,14 @@ class MinMax : public Strategy {
  private:
   const std::optional<const size_t> MaxDepth;
 
-  WinState PlayRecursive(Game::Game game, const size_t depth) const;
+  // Searches every move up to `maxDepth`, and returns the best one with its
+  // value
+  std::pair<Game::Move, WinState> Search(const Game::Game& game,
+                                         const std::optional<size_t> maxDepth,
+                                         const SearchLimits& limits);
+  WinState PlayRecursive(Game::Game game, const size_t depth,
+                         const std::optional<size_t> maxDepth,
+                         const SearchLimits& limits, size_t& nodeCount) const;
 };
 
 }  // namespace Strategy
@@ -7,7 +7,8 @@ namespace Strategy {
 
 MonteCarlo::MonteCarlo(size_t repeatCount) : RepeatCount(repeatCount) {}
 
-Game::Move MonteCarlo::GetMove(const Game::Game& game) {
+Game::Move MonteCarlo::GetMove(const Game::Game& game,
+                               const SearchLimits& limits) {
   const std::vector<Game::Move>& validMoves = game.GetValidMoves();
 
   Game::Move bestMove = validMoves[0];
@@ -17,8 +18,12 @@ Game::Move MonteCarlo::GetMove(const Game::Game& game) {
     size_t winCount = 0;
 
     for (size_t i = 0; i < RepeatCount; i++) {
+      // Out of time: only compare the moves that were fully simulated
+      if (limits.Expired()) return bestMove;
+
       Game::Game nextState = Game::Game(game);
       nextState.DoMove(move);
+      NodeCount++;
 
       winCount += RunSimulation(nextState) == game.GetCurrentPlayer();
     }
@@ -36,7 +41,8 @@ Game::Move MonteCarlo::GetMove(const Game::Game& game) {
 
 Color MonteCarlo::RunSimulation(Game::Game& game) {
   while (!game.IsFinished()) {
-    game.DoMove(RandomStrategy.GetMove(game));
+    game.DoMove(RandomStrategy.GetMove(game, SearchLimits()));
+    NodeCount++;
   }
 
   return game.IsFinished().value();
@@ -10,7 +10,8 @@ class MonteCarlo : public Strategy {
  public:
   MonteCarlo(size_t repeatCount);
 
-  Game::Move GetMove(const Game::Game& game) override;
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
 
   static std::optional<std::function<std::unique_ptr<MonteCarlo>()>> Parse(
       std::istringstream& stream);
@@ -0,0 +1,63 @@
+#include "ponderer.h"
+
+namespace Strategy {
+
+Ponderer::Ponderer(std::unique_ptr<Strategy> strategy)
+    : Inner(std::move(strategy)) {}
+
+Ponderer::~Ponderer() { StopPondering(); }
+
+Game::Move Ponderer::GetMove(const Game::Game& game,
+                             const SearchLimits& limits) {
+  StopPondering();
+
+  const auto found = Replies.find(game.GetPositionKey());
+  if (found != Replies.end()) {
+    const Game::Move move = found->second;
+    Replies.clear();
+    return move;
+  }
+
+  Replies.clear();
+  return Inner->GetMove(game, limits);
+}
+
+void Ponderer::Ponder(const Game::Game& game) {
+  StopPondering();
+  Replies.clear();
+
+  if (!Inner->SupportsPondering() || game.IsFinished()) return;
+
+  WorkerStopSource = std::stop_source();
+  Worker = std::thread(&Ponderer::PonderReplies, this, game,
+                       WorkerStopSource.get_token());
+}
+
+void Ponderer::StopPondering() {
+  WorkerStopSource.request_stop();
+  if (Worker.joinable()) Worker.join();
+}
+
+void Ponderer::PonderReplies(const Game::Game game,
+                             const std::stop_token stopToken) {
+  const SearchLimits limits{.StopToken = stopToken};
+
+  for (const Game::Move reply : game.GetValidMoves()) {
+    if (stopToken.stop_requested()) return;
+
+    Game::Game nextState = Game::Game(game);
+    nextState.DoMove(reply);
+    if (nextState.IsFinished()) continue;
+
+    const Game::PositionKey key = nextState.GetPositionKey();
+    if (Replies.contains(key)) continue;
+
+    const Game::Move move = Inner->GetMove(nextState, limits);
+
+    // An interrupted search only returns a guess
+    if (stopToken.stop_requested()) return;
+    Replies.emplace(key, move);
+  }
+}
+
+}  // namespace Strategy
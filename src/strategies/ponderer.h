@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+
+#include "strategy.h"
+
+namespace Strategy {
+
+// Wraps a strategy, and computes its replies to each of the opponent's moves
+// on a background thread while the opponent is thinking
+class Ponderer : public Strategy {
+ public:
+  Ponderer(std::unique_ptr<Strategy> strategy);
+  ~Ponderer() override;
+
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
+
+  void Ponder(const Game::Game& game) override;
+  void StopPondering() override;
+
+  bool SupportsPondering() const override { return false; }
+
+  size_t GetNodeCount() const override { return Inner->GetNodeCount(); }
+
+ private:
+  std::unique_ptr<Strategy> Inner;
+
+  std::thread Worker;
+  std::stop_source WorkerStopSource;
+
+  // Only accessed by the worker while it is running, and by the caller after
+  // it has been joined
+  std::unordered_map<Game::PositionKey, Game::Move> Replies;
+
+  void PonderReplies(const Game::Game game, const std::stop_token stopToken);
+};
+
+}  // namespace Strategy
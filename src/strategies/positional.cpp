@@ -8,12 +8,32 @@
 
 namespace Strategy {
 
-Positional::Positional() : Graph(StateGraph::SharedGameStateGraph) {}
+// Guards StateGraph::SharedGameStateGraph for all default instances
+static const std::shared_ptr<std::mutex> SharedGameStateGraphMutex =
+    std::make_shared<std::mutex>();
 
-Positional::Positional(std::shared_ptr<StateGraph::Graph> graph)
-    : Graph(graph) {}
+Positional::Positional()
+    : Graph(StateGraph::SharedGameStateGraph),
+      GraphMutex(SharedGameStateGraphMutex) {}
 
-Game::Move Positional::GetMove(const Game::Game& game) {
+Positional::Positional(std::shared_ptr<StateGraph::Graph> graph,
+                       std::shared_ptr<std::mutex> graphMutex)
+    : Graph(graph), GraphMutex(graphMutex) {}
+
+Game::Move Positional::GetMove(const Game::Game& game,
+                               const SearchLimits& limits) {
+  const std::lock_guard<std::mutex> lock(*GraphMutex);
+  const Game::Move move = FindMove(game, limits);
+
+  // Hand the rest of this thread's arena block back to the graph, as pondering
+  // and pool threads may end without searching it again
+  Graph->Objects->Detach();
+
+  return move;
+}
+
+Game::Move Positional::FindMove(const Game::Game& game,
+                                const SearchLimits& limits) {
   // Try to get a precomputed optimal move
   std::optional<std::weak_ptr<const StateGraph::Vertex>> found =
       Graph->Get(game);
@@ -26,8 +46,10 @@ Game::Move Positional::GetMove(const Game::Game& game) {
     if (optimalMove.has_value()) return optimalMove.value();
   }
 
-  // Compute the optimal move
-  StateGraph::Strategies::ForwardRetrogradeAnalysis(*Graph, game);
+  // Compute the optimal move. Only the vertices expanded for this move are
+  // counted, as the graph may be shared with other strategies.
+  NodeCount += StateGraph::Strategies::ForwardRetrogradeAnalysis(
+      *Graph, game, std::nullopt, [&limits] { return limits.Expired(); });
 
   found = Graph->Get(game);
 
@@ -39,11 +61,31 @@ Game::Move Positional::GetMove(const Game::Game& game) {
     if (optimalMove.has_value()) return optimalMove.value();
   }
 
+  if (limits.Expired()) return GetFallbackMove(game);
+
   std::cerr << "Failed to find optimal move! Defaulting to first valid move."
             << std::endl;
   return game.GetValidMoves()[0];
 }
 
+Game::Move Positional::GetFallbackMove(const Game::Game& game) const {
+  // Avoid moves into states that are known to be won by the opponent
+  const std::vector<Game::Move>& moves = game.GetValidMoves();
+  for (const Game::Move move : moves) {
+    Game::Game nextState = Game::Game(game);
+    nextState.DoMove(move);
+
+    const std::optional<std::weak_ptr<const StateGraph::Vertex>> found =
+        Graph->Get(nextState);
+    if (!found.has_value()) return move;
+
+    const std::shared_ptr<const StateGraph::Vertex> vertex = found->lock();
+    if (vertex == nullptr || vertex->Quality != WinState::Win) return move;
+  }
+
+  return moves[0];
+}
+
 std::optional<std::function<std::unique_ptr<Positional>()>> Positional::Parse(
     std::istringstream& stream) {
   std::string argument;
@@ -69,8 +111,12 @@ std::optional<std::function<std::unique_ptr<Positional>()>> Positional::Parse(
     }
   }
 
-  return [graph] {
-    return graph ? std::make_unique<Positional>(graph.value())
+  // The instances of an imported graph may play concurrently
+  const std::shared_ptr<std::mutex> graphMutex =
+      std::make_shared<std::mutex>();
+
+  return [graph, graphMutex] {
+    return graph ? std::make_unique<Positional>(graph.value(), graphMutex)
                  : std::make_unique<Positional>();
   };
 }
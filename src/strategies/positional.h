@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 
 #include "../stateGraph/stateGraph.h"
@@ -12,9 +13,18 @@ namespace Strategy {
 class Positional : public Strategy {
  public:
   Positional();
-  Positional(std::shared_ptr<StateGraph::Graph> graph);
+  // Instances sharing a graph must share its mutex, as moves are searched by
+  // expanding the graph
+  Positional(std::shared_ptr<StateGraph::Graph> graph,
+             std::shared_ptr<std::mutex> graphMutex =
+                 std::make_shared<std::mutex>());
 
-  Game::Move GetMove(const Game::Game& game) override;
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
+
+  // A graph shared with other instances is locked while searching, so
+  // pondering on it would stall the instances that are to move
+  bool SupportsPondering() const override { return Graph.use_count() <= 1; }
 
   static std::optional<std::function<std::unique_ptr<Positional>()>> Parse(
       std::istringstream& stream);
@@ -33,10 +43,20 @@ class Positional : public Strategy {
   }
 
   std::shared_ptr<const StateGraph::Graph> GetGraph() const { return Graph; }
-  void SetGraph(std::shared_ptr<StateGraph::Graph> graph) { Graph = graph; }
+  void SetGraph(std::shared_ptr<StateGraph::Graph> graph) {
+    Graph = graph;
+    GraphMutex = std::make_shared<std::mutex>();
+  }
 
  private:
   std::shared_ptr<StateGraph::Graph> Graph;
+  std::shared_ptr<std::mutex> GraphMutex;
+
+  // Looks up or searches the optimal move, with the graph locked
+  Game::Move FindMove(const Game::Game& game, const SearchLimits& limits);
+
+  // The best guess at a good move when out of time
+  Game::Move GetFallbackMove(const Game::Game& game) const;
 };
 
 }  // namespace Strategy
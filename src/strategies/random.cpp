@@ -1,10 +1,14 @@
 #include "random.h"
 
+#include <iostream>
+
 namespace Strategy {
 
-Random::Random() : Generator(RandomDevice()) {}
+Random::Random(const std::optional<uint32_t> seed)
+    : Generator(seed ? seed.value() : RandomDevice()) {}
 
-Game::Move Random::GetMove(const Game::Game& game) {
+Game::Move Random::GetMove(const Game::Game& game,
+                           const SearchLimits& limits) {
   const std::vector<Game::Move>& validMoves = game.GetValidMoves();
 
   std::uniform_int_distribution<size_t> randomMove(0, validMoves.size() - 1);
@@ -14,7 +18,22 @@ Game::Move Random::GetMove(const Game::Game& game) {
 
 std::optional<std::function<std::unique_ptr<Random>()>> Random::Parse(
     std::istringstream& stream) {
-  return std::make_unique<Random>;
+  std::string argument;
+  stream >> argument;
+  Parse::ToLower(argument);
+
+  if (argument != "--seed") {
+    Parse::Unparse(stream, argument);
+    return [] { return std::make_unique<Random>(); };
+  }
+
+  uint32_t seed;
+  if (!(stream >> seed)) {
+    std::cerr << "Failed to parse seed for Random strategy!" << std::endl;
+    return std::nullopt;
+  }
+
+  return [seed] { return std::make_unique<Random>(seed); };
 }
 
 }  // namespace Strategy
\ No newline at end of file
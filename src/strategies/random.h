@@ -13,9 +13,11 @@ namespace Strategy {
 
 class Random : public Strategy {
  public:
-  Random();
+  // Seeded randomly if no seed is provided
+  Random(const std::optional<uint32_t> seed = std::nullopt);
 
-  Game::Move GetMove(const Game::Game& game) override;
+  Game::Move GetMove(const Game::Game& game,
+                     const SearchLimits& limits) override;
 
   static std::optional<std::function<std::unique_ptr<Random>()>> Parse(
       std::istringstream& stream);
@@ -23,8 +25,11 @@ class Random : public Strategy {
   constexpr static std::string GetName() { return "random"; }
 
   constexpr static std::string GetHelpEntry() {
-    return Parse::PadCommandName(
-        "Random", "Choose a random valid move, uniformly distributed.");
+    constexpr std::string_view name = "Random [--seed <seed>]";
+    constexpr std::array<std::string_view, 2> description{
+        "Choose a random valid move, uniformly distributed.",
+        "Optionally seed the choice, for reproducible games."};
+    return Parse::PadCommandName(name, description);
   }
 
  private:
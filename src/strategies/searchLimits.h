@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <stop_token>
+
+namespace Strategy {
+
+// Bounds on the time a strategy may spend searching for a move. Strategies
+// poll Expired() and return the best move found so far once it is set.
+struct SearchLimits {
+  std::optional<std::chrono::steady_clock::time_point> Deadline = std::nullopt;
+  std::stop_token StopToken;
+
+  bool Expired() const {
+    return StopToken.stop_requested() ||
+           (Deadline.has_value() &&
+            std::chrono::steady_clock::now() >= Deadline.value());
+  }
+};
+
+}  // namespace Strategy
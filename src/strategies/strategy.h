@@ -2,6 +2,7 @@
 
 #include "../game/game.h"
 #include "../game/move.h"
+#include "searchLimits.h"
 
 namespace Strategy {
 
@@ -9,7 +10,24 @@ class Strategy {
  public:
   virtual ~Strategy() = default;
 
-  virtual Game::Move GetMove(const Game::Game& game) = 0;
+  virtual Game::Move GetMove(const Game::Game& game,
+                             const SearchLimits& limits) = 0;
+
+  // Called after this strategy has moved, with the opponent to move in `game`.
+  // Strategies may use the opponent's turn to think ahead, but must return
+  // promptly from both calls.
+  virtual void Ponder(const Game::Game&) {}
+  virtual void StopPondering() {}
+
+  // Whether GetMove may be called from a background thread while the opponent
+  // is thinking
+  virtual bool SupportsPondering() const { return true; }
+
+  // The number of positions this strategy has searched so far
+  virtual size_t GetNodeCount() const { return NodeCount; }
+
+ protected:
+  size_t NodeCount = 0;
 };
 
 }  // namespace Strategy
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <new>
+
+namespace Allocations {
+
+#ifdef ONITAMA_ALLOCATION_PROFILING
+
+namespace {
+
+struct Counters {
+  std::atomic<size_t> Allocations = 0;
+  std::atomic<size_t> Bytes = 0;
+  std::atomic<size_t> Deallocations = 0;
+  std::atomic<size_t> FreedBytes = 0;
+};
+
+std::array<Counters, SUBSYSTEM_COUNT> Current;
+
+// Precedes every allocation, so that its deallocation is attributed to the
+// subsystem that allocated it. Keeps the alignment operator new guarantees.
+struct alignas(std::max_align_t) Header {
+  size_t Size;
+  Subsystem Owner;
+};
+
+}  // namespace
+
+void* Allocate(const size_t size) {
+  void* block = std::malloc(sizeof(Header) + size);
+  if (block == nullptr) throw std::bad_alloc();
+
+  Header* header = new (block) Header{size, CurrentSubsystem};
+  Counters& counters = Current[(size_t)header->Owner];
+  counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.Bytes.fetch_add(size, std::memory_order_relaxed);
+
+  return header + 1;
+}
+
+void Deallocate(void* pointer) {
+  if (pointer == nullptr) return;
+
+  Header* header = (Header*)pointer - 1;
+  Counters& counters = Current[(size_t)header->Owner];
+  counters.Deallocations.fetch_add(1, std::memory_order_relaxed);
+  counters.FreedBytes.fetch_add(header->Size, std::memory_order_relaxed);
+
+  std::free(header);
+}
+
+void Record(const Subsystem subsystem, const size_t size) {
+  Counters& counters = Current[(size_t)subsystem];
+  counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.Bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void Release(const Subsystem subsystem, const size_t count,
+             const size_t bytes) {
+  Counters& counters = Current[(size_t)subsystem];
+  counters.Deallocations.fetch_add(count, std::memory_order_relaxed);
+  counters.FreedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+Report GetReport() {
+  Report report;
+  for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+    const size_t allocations = Current[i].Allocations;
+    const size_t bytes = Current[i].Bytes;
+    const size_t deallocations = Current[i].Deallocations;
+    const size_t freedBytes = Current[i].FreedBytes;
+
+    report[i] = {.Allocations = allocations,
+                 .Bytes = bytes,
+                 .LiveObjects = allocations - deallocations,
+                 .LiveBytes = bytes - freedBytes};
+  }
+
+  return report;
+}
+
+#else
+
+void Record(Subsystem, size_t) {}
+void Release(Subsystem, size_t, size_t) {}
+
+Report GetReport() { return {}; }
+
+#endif
+
+std::string ToJson(const Report& since, const size_t indentation) {
+  const std::string indent(indentation, ' ');
+  const Report report = GetReport();
+
+  std::string json = "{\n";
+  for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+    json += std::format(
+        "{}  \"{}\": {{\"allocations\": {}, \"bytes\": {}, "
+        "\"live_objects\": {}, \"live_bytes\": {}}}{}\n",
+        indent, SUBSYSTEM_NAMES[i],
+        report[i].Allocations - since[i].Allocations,
+        report[i].Bytes - since[i].Bytes, report[i].LiveObjects,
+        report[i].LiveBytes, i + 1 == SUBSYSTEM_COUNT ? "" : ",");
+  }
+  json += indent + "}";
+
+  return json;
+}
+
+}  // namespace Allocations
+
+#ifdef ONITAMA_ALLOCATION_PROFILING
+
+void* operator new(const size_t size) {
+  return Allocations::Allocate(size);
+}
+void* operator new[](const size_t size) {
+  return Allocations::Allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  Allocations::Deallocate(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+  Allocations::Deallocate(pointer);
+}
+void operator delete(void* pointer, size_t) noexcept {
+  Allocations::Deallocate(pointer);
+}
+void operator delete[](void* pointer, size_t) noexcept {
+  Allocations::Deallocate(pointer);
+}
+
+#endif
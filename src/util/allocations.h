@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Counts of heap allocations per subsystem, to tell where heap churn comes
+// from. Only compiled in with the ONITAMA_ALLOCATION_PROFILING CMake option,
+// which replaces the global operator new and delete.
+namespace Allocations {
+
+#ifdef ONITAMA_ALLOCATION_PROFILING
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+enum class Subsystem : uint8_t {
+  Cli,
+  Game,
+  Strategies,
+  StateGraph,
+  SaveSystem,
+  SubsystemCount,
+};
+
+constexpr size_t SUBSYSTEM_COUNT = (size_t)Subsystem::SubsystemCount;
+constexpr std::array<const char*, SUBSYSTEM_COUNT> SUBSYSTEM_NAMES = {
+    "cli", "game", "strategies", "state_graph", "save_system"};
+
+struct Counts {
+  size_t Allocations = 0;
+  size_t Bytes = 0;
+  // Allocations that have not been freed yet
+  size_t LiveObjects = 0;
+  size_t LiveBytes = 0;
+};
+
+using Report = std::array<Counts, SUBSYSTEM_COUNT>;
+
+#ifdef ONITAMA_ALLOCATION_PROFILING
+// The subsystem the allocations of this thread are attributed to. Anything
+// outside of a scope is attributed to the CLI.
+inline thread_local Subsystem CurrentSubsystem = Subsystem::Cli;
+#endif
+
+// Attributes the allocations of the current thread to `subsystem` for its
+// lifetime. Costs nothing unless allocation profiling is compiled in.
+class Scope {
+ public:
+#ifdef ONITAMA_ALLOCATION_PROFILING
+  Scope(Subsystem subsystem) : Previous(CurrentSubsystem) {
+    CurrentSubsystem = subsystem;
+  }
+  ~Scope() { CurrentSubsystem = Previous; }
+#else
+  Scope(Subsystem) {}
+#endif
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+#ifdef ONITAMA_ALLOCATION_PROFILING
+ private:
+  Subsystem Previous;
+#endif
+};
+
+#ifdef ONITAMA_ALLOCATION_PROFILING
+// Back the replaced global operator new and delete
+void* Allocate(size_t size);
+void Deallocate(void* pointer);
+#endif
+
+// Count objects that are not allocated through the global operator new, such as
+// those handed out by the arenas of state graphs. Do nothing unless allocation
+// profiling is compiled in.
+void Record(Subsystem subsystem, size_t size);
+void Release(Subsystem subsystem, size_t count, size_t bytes);
+
+// The counts since the start of the process
+Report GetReport();
+
+// The counts as a JSON object, with the allocations and bytes since `since`
+std::string ToJson(const Report& since = {}, size_t indentation = 0);
+
+}  // namespace Allocations
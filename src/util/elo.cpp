@@ -0,0 +1,40 @@
+#include "elo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Elo {
+
+static constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+double FromScore(const double score) {
+  if (score <= 0.0) return -Infinity;
+  if (score >= 1.0) return Infinity;
+
+  return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+Estimate FromResults(const size_t wins, const size_t draws,
+                     const size_t losses, const double z) {
+  const double games = (double)(wins + draws + losses);
+  if (games == 0.0) return Estimate{0.0, -Infinity, Infinity};
+
+  const double winRatio = wins / games;
+  const double drawRatio = draws / games;
+  const double lossRatio = losses / games;
+
+  const double score = winRatio + drawRatio / 2.0;
+  const double variance = winRatio * std::pow(1.0 - score, 2.0) +
+                          drawRatio * std::pow(0.5 - score, 2.0) +
+                          lossRatio * std::pow(0.0 - score, 2.0);
+  const double error = std::sqrt(variance / games);
+
+  return Estimate{
+      .Difference = FromScore(score),
+      .Lower = FromScore(std::clamp(score - z * error, 0.0, 1.0)),
+      .Upper = FromScore(std::clamp(score + z * error, 0.0, 1.0)),
+  };
+}
+
+}  // namespace Elo
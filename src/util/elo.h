@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Elo {
+
+// An Elo difference, with the bounds of its confidence interval
+struct Estimate {
+  double Difference;
+  double Lower;
+  double Upper;
+};
+
+// The Elo difference that corresponds to an expected score in [0, 1]
+double FromScore(const double score);
+
+// Estimates the Elo difference from a player's results, with a confidence
+// interval of `z` standard errors around the mean score
+Estimate FromResults(const size_t wins, const size_t draws,
+                     const size_t losses, const double z = 1.96);
+
+}  // namespace Elo
@@ -0,0 +1,70 @@
+#include "memory.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#elif defined(__unix__)
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <fstream>
+#endif
+
+namespace Memory {
+
+std::optional<size_t> GetPeakResidentMemory() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return std::nullopt;
+
+  return counters.PeakWorkingSetSize;
+#elif defined(__unix__) || defined(__APPLE__)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return std::nullopt;
+
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  // Reported in kilobytes
+  return usage.ru_maxrss * size_t{1024};
+#endif
+#else
+  return std::nullopt;
+#endif
+}
+
+std::optional<size_t> GetResidentMemory() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return std::nullopt;
+
+  return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info,
+                &count) != KERN_SUCCESS) {
+    return std::nullopt;
+  }
+
+  return info.resident_size;
+#elif defined(__unix__)
+  // The second field is the resident set size, in pages
+  std::ifstream stream("/proc/self/statm");
+  size_t totalPages, residentPages;
+  if (!(stream >> totalPages >> residentPages)) return std::nullopt;
+
+  return residentPages * (size_t)sysconf(_SC_PAGESIZE);
+#else
+  return std::nullopt;
+#endif
+}
+
+}  // namespace Memory
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace Memory {
+
+// The peak resident memory of this process in bytes, if the platform
+// reports it
+std::optional<size_t> GetPeakResidentMemory();
+// The current resident memory of this process in bytes, if the platform
+// reports it
+std::optional<size_t> GetResidentMemory();
+
+}  // namespace Memory
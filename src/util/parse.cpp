@@ -136,14 +136,28 @@ bool GameConfiguration::IsValid() const {
   return true;
 }
 
-std::optional<Game::Game> GameConfiguration::ToGame() const {
+std::optional<Game::Game> GameConfiguration::ToGame(
+    const std::optional<uint32_t> seed) const {
   if (!IsValid()) return std::nullopt;
 
   if (Cards)
     return Game::Game(Dimensions.first, Dimensions.second, Cards.value());
 
   return Game::Game::WithRandomCards(Dimensions.first, Dimensions.second,
-                                     RepeatCards);
+                                     RepeatCards, seed);
+}
+
+GameConfiguration GameConfiguration::WithDrawnCards(
+    const std::optional<uint32_t> seed) const {
+  GameConfiguration configuration = *this;
+  if (configuration.Cards) return configuration;
+
+  const Game::Game game = Game::Game::WithRandomCards(
+      Dimensions.first, Dimensions.second, RepeatCards, seed);
+
+  configuration.Cards.emplace();
+  std::ranges::copy(game.GetCards(), configuration.Cards->begin());
+  return configuration;
 }
 
 }  // namespace Parse
@@ -60,7 +60,14 @@ struct GameConfiguration {
   bool RepeatCards = false;
   std::optional<std::array<Game::Card, CARD_COUNT>> Cards;
 
-  std::optional<Game::Game> ToGame() const;
+  // Random cards are drawn with `seed`, if provided
+  std::optional<Game::Game> ToGame(
+      const std::optional<uint32_t> seed = std::nullopt) const;
+
+  // A copy with its cards fixed, drawing random ones if none are set, so that
+  // multiple games can be played on the same deal
+  GameConfiguration WithDrawnCards(
+      const std::optional<uint32_t> seed = std::nullopt) const;
 };
 
 }  // namespace Parse
@@ -0,0 +1,110 @@
+#include "progress.h"
+
+#include <format>
+#include <iostream>
+#include <string>
+
+#include "memory.h"
+
+namespace Progress {
+
+static std::string FormatDuration(const std::chrono::seconds duration) {
+  const size_t seconds = duration.count();
+  return std::format("{}:{:02}:{:02}", seconds / 3600, seconds / 60 % 60,
+                     seconds % 60);
+}
+
+PhaseScope::PhaseScope(const char* phase)
+    : PreviousPhase(Current.Phase.exchange(phase)),
+      PreviousPhaseStart(
+          Current.PhaseStart.exchange(std::chrono::steady_clock::now())),
+      PreviousWorkDone(Current.WorkDone.exchange(0)),
+      PreviousWorkTotal(Current.WorkTotal.exchange(0)) {}
+
+PhaseScope::~PhaseScope() {
+  Current.Phase = PreviousPhase;
+  Current.PhaseStart = PreviousPhaseStart;
+  Current.WorkDone = PreviousWorkDone;
+  Current.WorkTotal = PreviousWorkTotal;
+}
+
+static void Reset() {
+  Current.Phase = "idle";
+  Current.PhaseStart = std::chrono::steady_clock::now();
+
+  for (std::atomic<size_t>* counter :
+       {&Current.Vertices, &Current.Edges, &Current.Expansions,
+        &Current.Frontier, &Current.Labelled, &Current.Unlabelled,
+        &Current.WorkDone, &Current.WorkTotal}) {
+    *counter = 0;
+  }
+}
+
+Reporter::Reporter(const std::chrono::seconds interval)
+    : Interval(interval),
+      StartTime(std::chrono::steady_clock::now()),
+      LastReportTime(StartTime) {
+  Reset();
+  Thread = std::thread(&Reporter::Run, this);
+}
+
+Reporter::~Reporter() {
+  {
+    std::lock_guard lock(Mutex);
+    Stopping = true;
+  }
+  Condition.notify_one();
+  Thread.join();
+}
+
+void Reporter::Run() {
+  std::unique_lock lock(Mutex);
+  while (!Condition.wait_for(lock, Interval, [this] { return Stopping; })) {
+    Report();
+  }
+}
+
+void Reporter::Report() {
+  const std::chrono::steady_clock::time_point now =
+      std::chrono::steady_clock::now();
+  const std::chrono::duration<double> sinceLastReport = now - LastReportTime;
+
+  const size_t expansions = Current.Expansions;
+  const double expansionRate =
+      (expansions - LastExpansions) / sinceLastReport.count();
+  LastExpansions = expansions;
+  LastReportTime = now;
+
+  std::string line = std::format(
+      "[{}] {}: {} vertices, {} edges, {:.0f} expansions/s, frontier {}",
+      FormatDuration(
+          std::chrono::duration_cast<std::chrono::seconds>(now - StartTime)),
+      Current.Phase.load(), Current.Vertices.load(), Current.Edges.load(),
+      expansionRate, Current.Frontier.load());
+
+  const size_t labelled = Current.Labelled;
+  const size_t unlabelled = Current.Unlabelled;
+  if (labelled + unlabelled > 0) {
+    line += std::format(", {} labelled, {} unlabelled", labelled, unlabelled);
+  }
+
+  const std::optional<size_t> memory = Memory::GetResidentMemory();
+  if (memory) line += std::format(", {:.1f} MiB", memory.value() / 1048576.0);
+
+  // Extrapolate from the progress through the current phase
+  const size_t workDone = Current.WorkDone;
+  const size_t workTotal = Current.WorkTotal;
+  if (workTotal > 0 && workDone > 0 && workDone <= workTotal) {
+    const double fraction = (double)workDone / workTotal;
+    const std::chrono::duration<double> elapsed =
+        now - Current.PhaseStart.load();
+    line += std::format(
+        ", {:.1f}% of {}, ETA {}", fraction * 100.0, Current.Phase.load(),
+        FormatDuration(std::chrono::seconds(
+            (size_t)(elapsed.count() * (1.0 - fraction) / fraction))));
+  }
+
+  std::cerr << line << std::endl;
+}
+
+}  // namespace Progress
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+// Live progress of long state graph runs, reported periodically on stderr so
+// that a stuck run can be told apart from a slow one
+namespace Progress {
+
+// Counters the state graph algorithms keep up to date. They are only read by
+// the reporter, so relaxed updates suffice.
+struct Counters {
+  // What the run is currently doing. Has to be a string literal.
+  std::atomic<const char*> Phase = "idle";
+
+  std::atomic<size_t> Vertices = 0;
+  std::atomic<size_t> Edges = 0;
+  std::atomic<size_t> Expansions = 0;
+  std::atomic<size_t> Frontier = 0;
+
+  // Vertices with and without a known quality, during retrograde analysis
+  std::atomic<size_t> Labelled = 0;
+  std::atomic<size_t> Unlabelled = 0;
+
+  // Progress through the current phase, if its amount of work is known
+  std::atomic<std::chrono::steady_clock::time_point> PhaseStart =
+      std::chrono::steady_clock::now();
+  std::atomic<size_t> WorkDone = 0;
+  std::atomic<size_t> WorkTotal = 0;
+};
+
+inline Counters Current;
+
+inline void Add(std::atomic<size_t>& counter, const size_t amount = 1) {
+  counter.fetch_add(amount, std::memory_order_relaxed);
+}
+inline void Set(std::atomic<size_t>& counter, const size_t value) {
+  counter.store(value, std::memory_order_relaxed);
+}
+
+// Sets the current phase for as long as it lives, restoring the previous one
+// afterwards
+class PhaseScope {
+ public:
+  PhaseScope(const char* phase);
+  ~PhaseScope();
+
+  PhaseScope(const PhaseScope&) = delete;
+  PhaseScope& operator=(const PhaseScope&) = delete;
+
+ private:
+  const char* PreviousPhase;
+  std::chrono::steady_clock::time_point PreviousPhaseStart;
+  size_t PreviousWorkDone;
+  size_t PreviousWorkTotal;
+};
+
+// Resets the counters, and prints them to stderr every `interval` for as long
+// as it lives
+class Reporter {
+ public:
+  Reporter(std::chrono::seconds interval);
+  ~Reporter();
+
+  Reporter(const Reporter&) = delete;
+  Reporter& operator=(const Reporter&) = delete;
+
+ private:
+  void Run();
+  void Report();
+
+  const std::chrono::seconds Interval;
+  const std::chrono::steady_clock::time_point StartTime;
+
+  size_t LastExpansions = 0;
+  std::chrono::steady_clock::time_point LastReportTime;
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  bool Stopping = false;
+
+  std::thread Thread;
+};
+
+}  // namespace Progress
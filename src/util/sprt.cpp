@@ -0,0 +1,72 @@
+#include "sprt.h"
+
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace Sprt {
+
+// The count added to each pentanomial score before estimating its variance
+static constexpr double PriorCount = 1e-3;
+
+// The expected score against an opponent `elo` points weaker
+static double ExpectedScore(const double elo) {
+  return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+Test::Test(const Parameters parameters) : TestParameters(parameters) {}
+
+void Test::AddPair(const size_t halfPoints) {
+  assert(halfPoints < Pentanomial.size());
+  Pentanomial[halfPoints]++;
+}
+
+size_t Test::GetPairCount() const {
+  return std::accumulate(Pentanomial.begin(), Pentanomial.end(), size_t{0});
+}
+
+double Test::GetLogLikelihoodRatio() const {
+  if (GetPairCount() == 0) return 0.0;
+
+  // Every score is given a small prior count, so that a tally where all
+  // pairs scored the same still has a positive variance
+  std::array<double, 5> counts;
+  for (size_t halfPoints = 0; halfPoints < Pentanomial.size(); halfPoints++)
+    counts[halfPoints] = Pentanomial[halfPoints] + PriorCount;
+  const double pairs = std::accumulate(counts.begin(), counts.end(), 0.0);
+
+  // Mean and variance of the per-game score of a pair
+  double mean = 0.0;
+  for (size_t halfPoints = 0; halfPoints < counts.size(); halfPoints++)
+    mean += counts[halfPoints] * (halfPoints / 4.0);
+  mean /= pairs;
+
+  double variance = 0.0;
+  for (size_t halfPoints = 0; halfPoints < counts.size(); halfPoints++)
+    variance += counts[halfPoints] * std::pow(halfPoints / 4.0 - mean, 2.0);
+  variance /= pairs;
+
+  const double score0 = ExpectedScore(TestParameters.Elo0);
+  const double score1 = ExpectedScore(TestParameters.Elo1);
+
+  return pairs * (score1 - score0) * (2.0 * mean - score0 - score1) /
+         (2.0 * variance);
+}
+
+double Test::GetLowerBound() const {
+  return std::log(TestParameters.Beta / (1.0 - TestParameters.Alpha));
+}
+
+double Test::GetUpperBound() const {
+  return std::log((1.0 - TestParameters.Beta) / TestParameters.Alpha);
+}
+
+Result Test::GetResult() const {
+  const double logLikelihoodRatio = GetLogLikelihoodRatio();
+
+  if (logLikelihoodRatio <= GetLowerBound()) return Result::AcceptH0;
+  if (logLikelihoodRatio >= GetUpperBound()) return Result::AcceptH1;
+  return Result::Continue;
+}
+
+}  // namespace Sprt
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace Sprt {
+
+struct Parameters {
+  double Elo0;
+  double Elo1;
+  double Alpha;
+  double Beta;
+};
+
+enum class Result {
+  Continue,
+  AcceptH0,
+  AcceptH1,
+};
+
+// A generalised sequential probability ratio test on game pairs, where each
+// strategy plays both colours on the same deal. Pairs are tallied by their
+// score in half points, from 0 to 4, and the log-likelihood ratio follows
+// from the normal approximation of this pentanomial distribution.
+class Test {
+ public:
+  Test(const Parameters parameters);
+
+  void AddPair(const size_t halfPoints);
+
+  double GetLogLikelihoodRatio() const;
+  double GetLowerBound() const;
+  double GetUpperBound() const;
+  Result GetResult() const;
+
+  size_t GetPairCount() const;
+  const std::array<size_t, 5>& GetPentanomial() const { return Pentanomial; }
+
+ private:
+  const Parameters TestParameters;
+  std::array<size_t, 5> Pentanomial{};
+};
+
+}  // namespace Sprt
@@ -0,0 +1,71 @@
+#include "stats.h"
+
+#include <format>
+#include <iostream>
+#include <string>
+
+#include "allocations.h"
+
+namespace Stats {
+
+// The allocation counts when counting started
+static Allocations::Report StartAllocations;
+
+void Start() {
+  for (std::atomic<size_t>* counter :
+       {&Current.HashCalls, &Current.EqualToCalls, &Current.GameCopies,
+        &Current.DoMoveCalls, &Current.RetrogradeSweeps,
+        &Current.LockAcquisitions, &Current.LockWaitNanoseconds}) {
+    *counter = 0;
+  }
+
+  if (Allocations::ENABLED) StartAllocations = Allocations::GetReport();
+
+  Enabled = true;
+}
+
+void Stop(const std::optional<TableStats>& vertices) {
+  Enabled = false;
+
+  const size_t hashCalls = Current.HashCalls;
+  const size_t equalToCalls = Current.EqualToCalls;
+
+  std::string json = "{\n";
+  json += std::format("  \"hash_calls\": {},\n", hashCalls);
+  json += std::format("  \"equal_to_calls\": {},\n", equalToCalls);
+  json += std::format("  \"equal_to_calls_per_hash\": {:.3f},\n",
+                      hashCalls == 0 ? 0.0 : (double)equalToCalls / hashCalls);
+  json += std::format("  \"game_copies\": {},\n", Current.GameCopies.load());
+  json += std::format("  \"do_move_calls\": {},\n", Current.DoMoveCalls.load());
+  json += std::format("  \"retrograde_sweeps\": {},\n",
+                      Current.RetrogradeSweeps.load());
+  json += std::format("  \"lock_acquisitions\": {},\n",
+                      Current.LockAcquisitions.load());
+  json += std::format("  \"lock_wait_ms\": {:.3f}",
+                      Current.LockWaitNanoseconds / 1e6);
+
+  if (vertices) {
+    json += ",\n  \"vertices\": {\n";
+    json += std::format("    \"size\": {},\n", vertices->Size);
+    json += std::format("    \"capacity\": {},\n", vertices->Capacity);
+    json += std::format("    \"max_probe_length\": {},\n",
+                        vertices->MaxProbeLength);
+    json += "    \"probe_histogram\": {";
+
+    bool first = true;
+    for (const auto [length, count] : vertices->ProbeHistogram) {
+      json += std::format("{}\"{}\": {}", first ? "" : ", ", length, count);
+      first = false;
+    }
+
+    json += "}\n  }";
+  }
+
+  if (Allocations::ENABLED)
+    json += ",\n  \"allocations\": " + Allocations::ToJson(StartAllocations, 2);
+
+  json += "\n}";
+  std::cout << json << std::endl;
+}
+
+}  // namespace Stats
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <optional>
+
+// Counters of how often the hot paths of the game and state graph code are
+// taken, printed as JSON to guide their tuning
+namespace Stats {
+
+// Whether events are counted. While disabled, counting an event costs no more
+// than checking this flag.
+inline std::atomic<bool> Enabled = false;
+
+struct Counters {
+  std::atomic<size_t> HashCalls = 0;
+  std::atomic<size_t> EqualToCalls = 0;
+  std::atomic<size_t> GameCopies = 0;
+  std::atomic<size_t> DoMoveCalls = 0;
+  std::atomic<size_t> RetrogradeSweeps = 0;
+
+  // Locks of the vertex table shards in DispersedFrontier
+  std::atomic<size_t> LockAcquisitions = 0;
+  std::atomic<size_t> LockWaitNanoseconds = 0;
+};
+
+inline Counters Current;
+
+inline void Count(std::atomic<size_t>& counter, const size_t amount = 1) {
+  if (Enabled.load(std::memory_order_relaxed))
+    counter.fetch_add(amount, std::memory_order_relaxed);
+}
+
+// Calls `lock`, counting the time spent waiting for it to return
+template <class Function>
+void LockCounted(const Function& lock) {
+  if (!Enabled.load(std::memory_order_relaxed)) {
+    lock();
+    return;
+  }
+
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  lock();
+  const std::chrono::nanoseconds wait =
+      std::chrono::steady_clock::now() - start;
+
+  Count(Current.LockAcquisitions);
+  Count(Current.LockWaitNanoseconds, wait.count());
+}
+
+// The shape of an open-addressing hash table, whose long probe sequences
+// betray a weak hash
+struct TableStats {
+  size_t Size = 0;
+  size_t Capacity = 0;
+  size_t MaxProbeLength = 0;
+  // The number of entries at each distance from the slot they hash to
+  std::map<size_t, size_t> ProbeHistogram;
+};
+
+// Resets the counters and starts counting
+void Start();
+// Stops counting, and prints the counters, the allocations per subsystem if
+// allocation profiling is compiled in and, if given, the shape of the state
+// graph's vertex table as JSON
+void Stop(const std::optional<TableStats>& vertices = std::nullopt);
+
+}  // namespace Stats
@@ -21,8 +21,8 @@ class Stopwatch {
   size_t GetRuntimeCount() const { return GetRuntime().count(); }
 
  private:
-  std::chrono::time_point<std::chrono::system_clock> StartTime;
-  std::chrono::time_point<std::chrono::system_clock> LastUpdateTime;
+  std::chrono::time_point<std::chrono::steady_clock> StartTime;
+  std::chrono::time_point<std::chrono::steady_clock> LastUpdateTime;
 
   bool Paused;
 };
@@ -4,20 +4,20 @@
 
 template <class period>
 Stopwatch<period>::Stopwatch(const bool start)
-    : StartTime(std::chrono::system_clock::now()),
+    : StartTime(std::chrono::steady_clock::now()),
       LastUpdateTime(StartTime),
       Paused(!start) {}
 
 template <class period>
 void Stopwatch<period>::Update() {
   if (Paused) return;
-  LastUpdateTime = std::chrono::system_clock::now();
+  LastUpdateTime = std::chrono::steady_clock::now();
 }
 
 template <class period>
 void Stopwatch<period>::Set(const std::chrono::duration<size_t, period> time,
                             const bool pause) {
-  LastUpdateTime = std::chrono::system_clock::now();
+  LastUpdateTime = std::chrono::steady_clock::now();
   StartTime = LastUpdateTime - time;
 
   Paused |= pause;  // Only pause; don't unpause
@@ -27,7 +27,7 @@ template <class period>
 void Stopwatch<period>::Play() {
   if (!Paused) return;
 
-  LastUpdateTime = std::chrono::system_clock::now();
+  LastUpdateTime = std::chrono::steady_clock::now();
   Paused = false;
 };
 
@@ -0,0 +1,43 @@
+#include "threadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  Workers.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; i++) {
+    Workers.emplace_back(&ThreadPool::Work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(TasksMutex);
+    Stopping = true;
+  }
+  TasksCondition.notify_all();
+
+  for (std::thread& worker : Workers) worker.join();
+}
+
+void ThreadPool::Work() {
+  while (true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(TasksMutex);
+      TasksCondition.wait(lock, [this] { return Stopping || !Tasks.empty(); });
+
+      // Finish all submitted tasks before stopping
+      if (Tasks.empty()) return;
+
+      task = std::move(Tasks.front());
+      Tasks.pop();
+    }
+
+    task();
+  }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A fixed number of worker threads, executing submitted tasks in order of
+// submission
+class ThreadPool {
+ public:
+  // A thread count of 0 uses one thread per hardware thread
+  ThreadPool(size_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  template <class Function>
+  std::future<std::invoke_result_t<Function>> Submit(Function task);
+
+  size_t GetThreadCount() const { return Workers.size(); }
+
+ private:
+  std::vector<std::thread> Workers;
+
+  std::queue<std::function<void()>> Tasks;
+  std::mutex TasksMutex;
+  std::condition_variable TasksCondition;
+  bool Stopping = false;
+
+  void Work();
+};
+
+#include "threadPool.tpp"
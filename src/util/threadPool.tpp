@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory>
+
+#include "threadPool.h"
+
+template <class Function>
+std::future<std::invoke_result_t<Function>> ThreadPool::Submit(Function task) {
+  using Result = std::invoke_result_t<Function>;
+
+  // std::function must be copyable, so share the packaged task
+  const std::shared_ptr<std::packaged_task<Result()>> packagedTask =
+      std::make_shared<std::packaged_task<Result()>>(std::move(task));
+  std::future<Result> future = packagedTask->get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(TasksMutex);
+    Tasks.emplace([packagedTask] { (*packagedTask)(); });
+  }
+  TasksCondition.notify_one();
+
+  return future;
+}
@@ -0,0 +1,150 @@
+#include "trace.h"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Trace {
+
+struct Event {
+  std::string_view Name;
+  Clock::time_point Start;
+  Clock::duration Duration;
+};
+
+// Each thread records into its own buffer, so that threads only contend
+// while the trace is being written
+struct ThreadBuffer {
+  size_t ThreadId = 0;
+
+  std::mutex Mutex;
+  std::vector<Event> Events;
+};
+
+static std::mutex BuffersMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+
+// The ids of exited threads are handed out again, so that short-lived threads
+// share a timeline instead of each getting their own
+static std::set<size_t> FreeThreadIds;
+static size_t NextThreadId = 0;
+
+static Clock::time_point Origin;
+
+struct ThreadHandle {
+  ThreadHandle() : Buffer(std::make_shared<ThreadBuffer>()) {
+    std::lock_guard lock(BuffersMutex);
+
+    if (FreeThreadIds.empty()) {
+      Buffer->ThreadId = NextThreadId++;
+    } else {
+      Buffer->ThreadId = *FreeThreadIds.begin();
+      FreeThreadIds.erase(FreeThreadIds.begin());
+    }
+
+    Buffers.push_back(Buffer);
+  }
+
+  ~ThreadHandle() {
+    std::lock_guard lock(BuffersMutex);
+    FreeThreadIds.insert(Buffer->ThreadId);
+  }
+
+  const std::shared_ptr<ThreadBuffer> Buffer;
+};
+
+static ThreadBuffer& GetThreadBuffer() {
+  thread_local const ThreadHandle handle;
+  return *handle.Buffer;
+}
+
+Scope::Scope(const std::string_view name) : Name(name) {
+  if (Enabled.load(std::memory_order_relaxed)) Start = Clock::now();
+}
+
+Scope::~Scope() {
+  if (!Start || !Enabled.load(std::memory_order_relaxed)) return;
+
+  const Clock::time_point end = Clock::now();
+
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard lock(buffer.Mutex);
+  buffer.Events.push_back(Event{
+      .Name = Name,
+      .Start = Start.value(),
+      .Duration = end - Start.value(),
+  });
+}
+
+void Start() {
+  std::lock_guard lock(BuffersMutex);
+  for (const std::shared_ptr<ThreadBuffer>& buffer : Buffers) {
+    std::lock_guard bufferLock(buffer->Mutex);
+    buffer->Events.clear();
+  }
+
+  Origin = Clock::now();
+  Enabled = true;
+}
+
+bool Stop(const std::filesystem::path& path) {
+  Enabled = false;
+
+  std::ofstream stream(path);
+  if (!stream.is_open()) {
+    std::cerr << std::format("Failed to open trace file \"{}\"!",
+                             path.string())
+              << std::endl;
+    return false;
+  }
+
+  const auto toMicroseconds = [](const Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  std::lock_guard lock(BuffersMutex);
+
+  stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+  bool first = true;
+  std::set<size_t> namedThreadIds;
+  for (const std::shared_ptr<ThreadBuffer>& buffer : Buffers) {
+    std::lock_guard bufferLock(buffer->Mutex);
+    if (buffer->Events.empty()) continue;
+
+    if (namedThreadIds.insert(buffer->ThreadId).second) {
+      stream << (first ? "\n" : ",\n");
+      first = false;
+
+      stream << std::format(
+          "{{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+          "\"tid\": {}, \"args\": {{\"name\": \"Thread {}\"}}}}",
+          buffer->ThreadId, buffer->ThreadId);
+    }
+
+    for (const Event& event : buffer->Events) {
+      stream << std::format(
+          ",\n{{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, "
+          "\"ts\": {:.3f}, \"dur\": {:.3f}}}",
+          event.Name, buffer->ThreadId, toMicroseconds(event.Start - Origin),
+          toMicroseconds(event.Duration));
+    }
+  }
+
+  stream << "\n]}" << std::endl;
+
+  // Forget the buffers of threads that have since exited
+  std::erase_if(Buffers, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+    return buffer.use_count() == 1;
+  });
+
+  std::cout << std::format("Wrote trace to \"{}\".", path.string())
+            << std::endl;
+  return true;
+}
+
+}  // namespace Trace
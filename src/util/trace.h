@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+// Scoped timing of the phases of long runs, exported in the Chrome trace
+// event format that chrome://tracing and Perfetto display
+namespace Trace {
+
+using Clock = std::chrono::steady_clock;
+
+// Whether scopes are being recorded. While disabled, a scope costs no more
+// than checking this flag.
+inline std::atomic<bool> Enabled = false;
+
+// Records the time between its construction and destruction as an event on
+// the current thread's timeline. `name` has to outlive the trace, so it
+// should be a string literal.
+class Scope {
+ public:
+  Scope(std::string_view name);
+  ~Scope();
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  std::string_view Name;
+  std::optional<Clock::time_point> Start;
+};
+
+// Discards all recorded events and starts recording
+void Start();
+// Stops recording, and writes the recorded events to `path`
+bool Stop(const std::filesystem::path& path);
+
+}  // namespace Trace
@@ -496,6 +496,29 @@ int Serialize() {
   return Pass;
 }
 
+int GetPositionKey() {
+  const GameSerialization serialization = TemplateGame->Serialize();
+  const PositionKey key = TemplateGame->GetPositionKey();
+
+  if (key.ToSerialization() != serialization) {
+    std::cerr << std::format("Expected position key to unpack to \"{}\", "
+                             "got \"{}\"!",
+                             serialization.to_string(),
+                             key.ToSerialization().to_string())
+              << std::endl;
+    return Fail;
+  }
+
+  Game::Game next(*TemplateGame);
+  next.DoMove(Move{2, Card(CardType::Goose), 0});
+  if (next.GetPositionKey() == key) {
+    std::cerr << "Different games have the same position key!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
 }  // namespace Game
 }  // namespace Game
 }  // namespace Tests
@@ -40,6 +40,7 @@ int IsFinished();
 int DoMove();
 
 int Serialize();
+int GetPositionKey();
 
 }  // namespace Game
 }  // namespace Game
@@ -0,0 +1,291 @@
+#include "gameMaster.h"
+
+#include <atomic>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+
+#include "../src/gameMaster.h"
+#include "../src/strategies/ponderer.h"
+#include "assertEqual.h"
+
+namespace Tests {
+namespace GameMaster {
+
+using namespace Game;
+
+// Moves the master forward once, and then back and forth sideways, so that
+// the same positions keep coming back when both players do so
+class Shuffle : public Strategy::Strategy {
+ public:
+  Move GetMove(const Game::Game& game,
+               const ::Strategy::SearchLimits& limits) override {
+    // Boar moves left, forward and right, in that order
+    const size_t offsetId = Ply == 0 ? 1 : Ply % 2 == 1 ? 2 : 0;
+    Ply++;
+
+    return Move{.PawnId = 0, .UsedCard = Card(CardType::Boar),
+                .OffsetId = offsetId};
+  }
+
+ private:
+  size_t Ply = 0;
+};
+
+// Plays a shuffling game under the provided draw rules, and checks that it is
+// drawn for `reason` after `plies` plies
+static int PlayUntilDraw(const std::optional<size_t> maxPlies,
+                         const std::optional<size_t> repetitions,
+                         const DrawReason reason, const size_t plies) {
+  std::array<Card, CARD_COUNT> cards;
+  cards.fill(Card(CardType::Boar));
+
+  ::GameMaster master(5, 5, std::make_unique<Shuffle>(),
+                      std::make_unique<Shuffle>(), cards);
+  master.GameMasterPrintType = PrintType::None;
+  master.SetDrawRules(maxPlies, repetitions);
+
+  while (!master.IsOver()) master.Update();
+
+  if (master.IsFinished()) {
+    std::cerr << "Game was won instead of drawn!" << std::endl;
+    return Fail;
+  }
+
+  if (master.IsDraw() != reason) {
+    std::cerr << "Game was drawn for the wrong reason!" << std::endl;
+    return Fail;
+  }
+
+  if (master.GetRound() != plies + 1) {
+    std::cerr << std::format("Game was drawn after {} plies instead of {}!",
+                             master.GetRound() - 1, plies)
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int MaxPlies() {
+  if (PlayUntilDraw(5, std::nullopt, DrawReason::MaxPlies, 5)) return Fail;
+
+  // Repetitions take precedence, even when they coincide with the ply limit
+  return PlayUntilDraw(10, 3, DrawReason::Repetition, 10);
+}
+
+int Repetition() {
+  // The position after both masters have moved forward comes back every four
+  // plies, for the third time after ten plies
+  if (PlayUntilDraw(std::nullopt, 3, DrawReason::Repetition, 10)) return Fail;
+
+  // Which happens after six plies when two occurrences suffice
+  if (PlayUntilDraw(std::nullopt, 2, DrawReason::Repetition, 6)) return Fail;
+
+  return PlayUntilDraw(9, 3, DrawReason::MaxPlies, 9);
+}
+
+// Sleeps for a fixed time before every move, regardless of its limits, or
+// until stopped if `Cooperative` is set
+class Sleeper : public Shuffle {
+ public:
+  Sleeper(const std::chrono::milliseconds duration, const bool cooperative)
+      : Duration(duration), Cooperative(cooperative) {}
+
+  Move GetMove(const Game::Game& game,
+               const ::Strategy::SearchLimits& limits) override {
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now() + Duration;
+    while (std::chrono::steady_clock::now() < end) {
+      if (Cooperative && limits.StopToken.stop_requested()) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return Shuffle::GetMove(game, limits);
+  }
+
+ private:
+  const std::chrono::milliseconds Duration;
+  const bool Cooperative;
+};
+
+// Plays a single move by a sleeping red player under a 20ms move time
+static ::GameMaster PlaySleeper(const bool cooperative) {
+  std::array<Card, CARD_COUNT> cards;
+  cards.fill(Card(CardType::Boar));
+
+  ::GameMaster master(
+      5, 5,
+      std::make_unique<Sleeper>(std::chrono::milliseconds(500), cooperative),
+      std::make_unique<Shuffle>(), cards);
+  master.GameMasterPrintType = PrintType::None;
+  master.SetTimeControl(std::chrono::milliseconds(20), std::nullopt);
+  master.Update();
+
+  return master;
+}
+
+int MoveTime() {
+  const ::GameMaster cooperative = PlaySleeper(true);
+  if (cooperative.IsOver() || cooperative.GetRound() != 2) {
+    std::cerr << "Player was not stopped at its move time!" << std::endl;
+    return Fail;
+  }
+
+  const ::GameMaster overrun = PlaySleeper(false);
+  if (!overrun.IsTimeForfeit() || overrun.IsFinished() != Color::Blue) {
+    std::cerr << "Player did not forfeit after overrunning its move time!"
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+// The calls a Probe has received
+struct ProbeCalls {
+  // Calls from the thread that made the probe, and from other threads
+  std::atomic<size_t> Searching = 0;
+  std::atomic<size_t> Pondering = 0;
+  std::atomic<size_t> ActivePondering = 0;
+  // Searching calls made while a pondering call was still running
+  std::atomic<size_t> Overlapping = 0;
+};
+
+// Plays the first valid move, and counts its calls. Pondering calls block
+// until they are stopped if `BlockPondering` is set.
+class Probe : public Strategy::Strategy {
+ public:
+  Probe(std::shared_ptr<ProbeCalls> calls, const bool blockPondering)
+      : Calls(calls),
+        BlockPondering(blockPondering),
+        Owner(std::this_thread::get_id()) {}
+
+  Move GetMove(const Game::Game& game,
+               const ::Strategy::SearchLimits& limits) override {
+    if (std::this_thread::get_id() != Owner) {
+      Calls->Pondering++;
+      Calls->ActivePondering++;
+      while (BlockPondering && !limits.Expired())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      Calls->ActivePondering--;
+    } else {
+      Calls->Searching++;
+      if (Calls->ActivePondering > 0) Calls->Overlapping++;
+    }
+
+    return game.GetValidMoves()[0];
+  }
+
+ private:
+  const std::shared_ptr<ProbeCalls> Calls;
+  const bool BlockPondering;
+  const std::thread::id Owner;
+};
+
+// Waits at most a few seconds for `Ready` to hold, before playing the first
+// valid move
+class Patient : public Strategy::Strategy {
+ public:
+  Patient(std::function<bool(const Game::Game&)> ready) : Ready(ready) {}
+
+  Move GetMove(const Game::Game& game,
+               const ::Strategy::SearchLimits& limits) override {
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!Ready(game) && std::chrono::steady_clock::now() < end)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    return game.GetValidMoves()[0];
+  }
+
+ private:
+  const std::function<bool(const Game::Game&)> Ready;
+};
+
+// The number of distinct positions the replies in `game` lead to, which a
+// ponderer searches
+static size_t CountReplies(const Game::Game& game) {
+  std::unordered_set<PositionKey> keys;
+  for (const Move reply : game.GetValidMoves()) {
+    Game::Game nextState = Game::Game(game);
+    nextState.DoMove(reply);
+    if (!nextState.IsFinished()) keys.insert(nextState.GetPositionKey());
+  }
+
+  return keys.size();
+}
+
+// A red pondering probe against a patient blue player
+static ::GameMaster MakePonderingGame(
+    std::shared_ptr<ProbeCalls> calls, const bool blockPondering,
+    std::function<bool(const Game::Game&)> ready) {
+  std::array<Card, CARD_COUNT> cards;
+  cards.fill(Card(CardType::Boar));
+
+  ::GameMaster master(5, 5,
+                      std::make_unique<::Strategy::Ponderer>(
+                          std::make_unique<Probe>(calls, blockPondering)),
+                      std::make_unique<Patient>(ready), cards);
+  master.GameMasterPrintType = PrintType::None;
+
+  return master;
+}
+
+int PonderHit() {
+  const std::shared_ptr<ProbeCalls> calls = std::make_shared<ProbeCalls>();
+
+  // Blue only moves once red has pondered all of its replies
+  ::GameMaster master =
+      MakePonderingGame(calls, false, [calls](const Game::Game& game) {
+        return calls->Pondering >= CountReplies(game);
+      });
+  master.Update();
+  master.Update();
+
+  const size_t searchCount = calls->Searching;
+  master.Update();
+
+  if (master.GetRound() != 4) {
+    std::cerr << "Pondering game did not advance!" << std::endl;
+    return Fail;
+  }
+
+  if (calls->Searching != searchCount) {
+    std::cerr << "Ponderer searched a reply it had already pondered!"
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int PonderJoin() {
+  const std::shared_ptr<ProbeCalls> calls = std::make_shared<ProbeCalls>();
+
+  // Blue moves while red is still pondering its first reply, so that red
+  // has to search its next move itself
+  ::GameMaster master = MakePonderingGame(
+      calls, true, [calls](const Game::Game&) { return calls->Pondering > 0; });
+  master.Update();
+  master.Update();
+  master.Update();
+
+  if (calls->Pondering == 0 || calls->Searching != 2) {
+    std::cerr << "Ponderer did not search after pondering!" << std::endl;
+    return Fail;
+  }
+
+  if (calls->Overlapping != 0) {
+    std::cerr << "Ponderer searched before its worker had stopped!"
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+}  // namespace GameMaster
+}  // namespace Tests
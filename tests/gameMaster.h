@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Tests {
+namespace GameMaster {
+
+int MaxPlies();
+int Repetition();
+int MoveTime();
+int PonderHit();
+int PonderJoin();
+
+}  // namespace GameMaster
+}  // namespace Tests
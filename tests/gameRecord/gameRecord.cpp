@@ -0,0 +1,170 @@
+#include "gameRecord.h"
+
+#include <format>
+#include <iostream>
+#include <thread>
+
+#include "../../src/gameRecord/gameRecord.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace GameRecord {
+
+using namespace ::GameRecord;
+
+static constexpr std::array<Game::Card, CARD_COUNT> TemplateCards = {
+    Game::Card(Game::CardType::Boar), Game::Card(Game::CardType::Ox),
+    Game::Card(Game::CardType::Crab), Game::Card(Game::CardType::Tiger),
+    Game::Card(Game::CardType::Goose)};
+
+static std::vector<Record> TemplateRecords;
+
+void Init() {
+  TemplateRecords.clear();
+
+  // A game played to its end by always taking the first valid move, and an
+  // unfinished one that was drawn
+  for (const size_t plyLimit : {SIZE_MAX, size_t{3}}) {
+    Record record{.Dimensions = {3, 4}, .Cards = TemplateCards};
+    record.Seed = TemplateRecords.size() + 42;
+
+    Game::Game game = record.GetInitialGame();
+    while (!game.IsFinished() && record.Moves.size() < plyLimit) {
+      const Game::Move move = game.GetValidMoves()[0];
+      record.Moves.push_back(move);
+      game.DoMove(move);
+    }
+    record.Winner = game.IsFinished();
+
+    TemplateRecords.push_back(record);
+  }
+}
+
+static std::optional<std::vector<Record>> ReadAll(
+    const std::filesystem::path& path) {
+  std::optional<Reader> reader = Reader::Open(path);
+  if (!reader) return std::nullopt;
+
+  std::vector<Record> records;
+  for (std::optional<Record> record = reader->Next(); record;
+       record = reader->Next()) {
+    records.push_back(record.value());
+  }
+
+  if (reader->HasError()) return std::nullopt;
+  return records;
+}
+
+int WriteRead() {
+  const std::filesystem::path outPath =
+      "./tests/Tests_GameRecord_WriteRead_output";
+
+  {
+    // A tiny buffer, so that records are flushed while writing as well
+    std::unique_ptr<Writer> writer = Writer::Open(outPath, 8);
+    if (writer == nullptr) return Fail;
+
+    for (const Record& record : TemplateRecords) writer->Write(record);
+  }
+
+  const std::optional<std::vector<Record>> records = ReadAll(outPath);
+  std::filesystem::remove(outPath);
+
+  if (!records) {
+    std::cerr << "Failed to read game records!" << std::endl;
+    return Fail;
+  }
+
+  if (records.value() != TemplateRecords) {
+    std::cerr << "Game records differ after reading!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int ConcurrentWrite() {
+  const std::filesystem::path outPath =
+      "./tests/Tests_GameRecord_ConcurrentWrite_output";
+  constexpr size_t threadCount = 4;
+  constexpr size_t recordsPerThread = 1000;
+
+  {
+    std::unique_ptr<Writer> writer = Writer::Open(outPath, 256);
+    if (writer == nullptr) return Fail;
+
+    std::vector<std::jthread> threads;
+    for (size_t thread = 0; thread < threadCount; thread++) {
+      threads.emplace_back([&writer] {
+        for (size_t record = 0; record < recordsPerThread; record++) {
+          writer->Write(TemplateRecords[record % TemplateRecords.size()]);
+        }
+      });
+    }
+  }
+
+  const std::optional<std::vector<Record>> records = ReadAll(outPath);
+  std::filesystem::remove(outPath);
+
+  if (!records) {
+    std::cerr << "Failed to read game records!" << std::endl;
+    return Fail;
+  }
+
+  if (records->size() != threadCount * recordsPerThread) {
+    std::cerr << std::format("Expected {} records; got {}!",
+                             threadCount * recordsPerThread, records->size())
+              << std::endl;
+    return Fail;
+  }
+
+  // Records may be interleaved, but each must be intact
+  for (const Record& record : records.value()) {
+    if (std::find(TemplateRecords.begin(), TemplateRecords.end(), record) ==
+        TemplateRecords.end()) {
+      std::cerr << "Found a corrupted record!" << std::endl;
+      return Fail;
+    }
+  }
+
+  return Pass;
+}
+
+int Truncated() {
+  const std::filesystem::path outPath =
+      "./tests/Tests_GameRecord_Truncated_output";
+
+  {
+    std::unique_ptr<Writer> writer = Writer::Open(outPath);
+    if (writer == nullptr) return Fail;
+
+    for (const Record& record : TemplateRecords) writer->Write(record);
+  }
+  std::filesystem::resize_file(outPath,
+                               std::filesystem::file_size(outPath) - 1);
+
+  std::optional<Reader> reader = Reader::Open(outPath);
+  if (!reader) {
+    std::filesystem::remove(outPath);
+    return Fail;
+  }
+
+  const std::optional<Record> first = reader->Next();
+  const std::optional<Record> second = reader->Next();
+  std::filesystem::remove(outPath);
+
+  if (first != TemplateRecords[0]) {
+    std::cerr << "First record differs after reading!" << std::endl;
+    return Fail;
+  }
+
+  if (second || !reader->HasError()) {
+    std::cerr << "Truncated record was not detected!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+}  // namespace GameRecord
+}  // namespace Tests
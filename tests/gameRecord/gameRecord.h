@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Tests {
+namespace GameRecord {
+
+void Init();
+
+int WriteRead();
+int ConcurrentWrite();
+int Truncated();
+
+}  // namespace GameRecord
+}  // namespace Tests
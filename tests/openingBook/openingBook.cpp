@@ -0,0 +1,160 @@
+#include "openingBook.h"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+#include "../../src/openingBook/openingBook.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace OpeningBook {
+
+using namespace ::OpeningBook;
+
+static constexpr std::array<Game::Card, CARD_COUNT> TemplateCards = {
+    Game::Card(Game::CardType::Boar), Game::Card(Game::CardType::Ox),
+    Game::Card(Game::CardType::Crab), Game::Card(Game::CardType::Tiger),
+    Game::Card(Game::CardType::Goose)};
+
+static std::unique_ptr<const Game::Game> TemplateGame;
+static std::unique_ptr<const Game::Game> TemplateNextGame;
+
+static std::unique_ptr<const Book> TemplateBook;
+
+void Init() {
+  TemplateGame = std::make_unique<const Game::Game>(3, 3, TemplateCards);
+
+  Game::Game next(*TemplateGame);
+  next.DoMove(TemplateGame->GetValidMoves()[0]);
+  TemplateNextGame = std::make_unique<const Game::Game>(std::move(next));
+
+  Builder builder;
+  builder.Add(*TemplateGame, TemplateGame->GetValidMoves()[1]);
+  builder.Add(*TemplateNextGame, TemplateNextGame->GetValidMoves()[0], 3);
+  TemplateBook = std::make_unique<const Book>(builder.Build());
+}
+
+int SaveLoad() {
+  const std::filesystem::path outPath =
+      "./tests/Tests_OpeningBook_SaveLoad_output";
+  std::filesystem::remove(outPath);
+
+  if (!TemplateBook->Save(outPath)) {
+    std::cerr << "Failed to save opening book!" << std::endl;
+    return Fail;
+  }
+
+  const std::optional<Book> book = Book::Load(outPath);
+  std::filesystem::remove(outPath);
+
+  if (!book) {
+    std::cerr << "Failed to load opening book!" << std::endl;
+    return Fail;
+  }
+
+  if (book->GetSize() != TemplateBook->GetSize()) {
+    std::cerr << std::format("Expected {} entries; got {}!",
+                             TemplateBook->GetSize(), book->GetSize())
+              << std::endl;
+    return Fail;
+  }
+
+  for (size_t entryId = 0; entryId < book->GetSize(); entryId++) {
+    const Entry& entry = book->GetEntries()[entryId];
+    const Entry& expected = TemplateBook->GetEntries()[entryId];
+
+    if (entry.Key != expected.Key || entry.Move != expected.Move ||
+        entry.Weight != expected.Weight) {
+      std::cerr << std::format("Entry {} differs after loading!", entryId)
+                << std::endl;
+      return Fail;
+    }
+  }
+
+  return Pass;
+}
+
+int LoadTruncated() {
+  const std::filesystem::path outPath =
+      "./tests/Tests_OpeningBook_LoadTruncated_output";
+  std::filesystem::remove(outPath);
+
+  if (!TemplateBook->Save(outPath)) {
+    std::cerr << "Failed to save opening book!" << std::endl;
+    return Fail;
+  }
+
+  // Drop part of the last entry
+  std::filesystem::resize_file(outPath,
+                               std::filesystem::file_size(outPath) - 1);
+  if (Book::Load(outPath)) {
+    std::filesystem::remove(outPath);
+    std::cerr << "Loaded an opening book with a partial entry!" << std::endl;
+    return Fail;
+  }
+
+  // Claim far more entries than the file holds
+  {
+    std::fstream stream(outPath,
+                        std::ios::in | std::ios::out | std::ios::binary);
+    const uint64_t entryCount = uint64_t{1} << 60;
+    stream.seekp(2 * sizeof(uint32_t));
+    stream.write((const char*)&entryCount, sizeof(entryCount));
+  }
+  const std::optional<Book> book = Book::Load(outPath);
+  std::filesystem::remove(outPath);
+
+  if (book) {
+    std::cerr << "Loaded an opening book with a corrupt entry count!"
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int Probe() {
+  const std::optional<Game::Move> move = TemplateBook->Probe(*TemplateGame);
+  if (move != TemplateGame->GetValidMoves()[1]) {
+    std::cerr << "Book did not return the stored move!" << std::endl;
+    return Fail;
+  }
+
+  Game::Game unknown(*TemplateNextGame);
+  unknown.DoMove(unknown.GetValidMoves()[0]);
+  if (TemplateBook->Probe(unknown).has_value()) {
+    std::cerr << "Book returned a move for an unknown position!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int Build() {
+  Builder builder;
+  const Game::Move popular = TemplateGame->GetValidMoves()[0];
+  const Game::Move unpopular = TemplateGame->GetValidMoves()[1];
+
+  builder.Add(*TemplateGame, unpopular, 2);
+  builder.Add(*TemplateGame, popular, 1);
+  builder.Add(*TemplateGame, popular, 2);
+
+  const Book book = builder.Build();
+  if (book.GetSize() != 1) {
+    std::cerr << std::format("Expected 1 entry; got {}!", book.GetSize())
+              << std::endl;
+    return Fail;
+  }
+
+  const Entry entry = book.GetEntries()[0];
+  if (Game::Move::Unpack(entry.Move) != popular || entry.Weight != 3) {
+    std::cerr << "Book did not keep the most played move!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+}  // namespace OpeningBook
+}  // namespace Tests
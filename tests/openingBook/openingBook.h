@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Tests {
+namespace OpeningBook {
+
+void Init();
+
+int SaveLoad();
+int LoadTruncated();
+int Probe();
+int Build();
+
+}  // namespace OpeningBook
+}  // namespace Tests
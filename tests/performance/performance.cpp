@@ -0,0 +1,227 @@
+#include "performance.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "../../src/stateGraph/strategies.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace Performance {
+
+using namespace ::Game;
+
+// Each workload is timed this many times, keeping the fastest run
+static constexpr size_t RUN_COUNT = 3;
+
+static const std::filesystem::path BaselinePath =
+    "./tests/resources/performance.csv";
+
+static constexpr std::array<Card, CARD_COUNT> Cards = {
+    Card(CardType::Ox), Card(CardType::Boar), Card(CardType::Elephant),
+    Card(CardType::Horse), Card(CardType::Mantis)};
+
+struct Baseline {
+  // Operations per second, relative to those of the calibration workload
+  double RelativeThroughput;
+  // The fraction of the baseline throughput that may be lost
+  double Tolerance;
+};
+
+static std::optional<Baseline> ReadBaseline(const std::string& name) {
+  std::ifstream stream(BaselinePath);
+  if (!stream.is_open()) {
+    std::cerr << std::format("Failed to open \"{}\"!", BaselinePath.string())
+              << std::endl;
+    return std::nullopt;
+  }
+
+  std::string line;
+  std::getline(stream, line);  // Header
+  while (std::getline(stream, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    std::istringstream lineStream(line);
+    std::string lineName, throughput, tolerance;
+    std::getline(lineStream, lineName, ',');
+    std::getline(lineStream, throughput, ',');
+    std::getline(lineStream, tolerance, ',');
+    if (lineName != name) continue;
+
+    try {
+      return Baseline{.RelativeThroughput = std::stod(throughput),
+                      .Tolerance = std::stod(tolerance)};
+    } catch (const std::exception&) {
+      std::cerr << std::format("Invalid baseline \"{}\"!", line) << std::endl;
+      return std::nullopt;
+    }
+  }
+
+  std::cerr << std::format("No baseline for \"{}\"!", name) << std::endl;
+  return std::nullopt;
+}
+
+// Runs `workload`, which returns its number of operations, and returns the
+// best throughput in operations per second.
+// If `setup` is given, it is run untimed before every run of `workload`.
+static double GetThroughput(const std::function<size_t()>& workload,
+                            const std::function<void()>& setup = nullptr) {
+  double throughput = 0.0;
+  for (size_t run = 0; run < RUN_COUNT; run++) {
+    if (setup) setup();
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t operations = workload();
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+
+    throughput = std::max(throughput, operations / duration.count());
+  }
+
+  return throughput;
+}
+
+// The throughput of sorting seeded random numbers, which does not depend on
+// the engine. The baselines are relative to it, so that they carry over to
+// machines of a different speed.
+static double GetCalibrationThroughput() {
+  constexpr size_t valueCount = size_t{1} << 20;
+  constexpr uint32_t seed = 0;
+
+  std::vector<uint32_t> values(valueCount);
+  return GetThroughput(
+      [&]() {
+        std::sort(values.begin(), values.end());
+        return valueCount;
+      },
+      [&]() {
+        std::mt19937 generator(seed);
+        std::ranges::generate(values, generator);
+      });
+}
+
+// Compares the throughput of `workload` relative to the calibration workload
+// against the baseline. The arguments are those of GetThroughput.
+static int Measure(const std::string& name,
+                   const std::function<size_t()>& workload,
+                   const std::function<void()>& setup = nullptr) {
+  const std::optional<Baseline> baseline = ReadBaseline(name);
+  if (!baseline.has_value()) return Fail;
+
+  const double calibration = GetCalibrationThroughput();
+  const double throughput = GetThroughput(workload, setup);
+  const double relativeThroughput = throughput / calibration;
+
+  const double minimum =
+      baseline->RelativeThroughput * (1.0 - baseline->Tolerance);
+  std::cout << std::format("{}: {:.0f} op/s, {:.4f} times the calibration of "
+                           "{:.0f} op/s (baseline {:.4f})",
+                           name, throughput, relativeThroughput, calibration,
+                           baseline->RelativeThroughput)
+            << std::endl;
+
+  if (relativeThroughput < minimum) {
+    std::cerr << std::format("Relative throughput of \"{}\" regressed below "
+                             "{:.4f}!",
+                             name, minimum)
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+static size_t CountLeaves(const ::Game::Game& game, const size_t depth) {
+  if (depth == 0 || game.IsFinished().has_value()) return 1;
+
+  size_t leaves = 0;
+  for (const Move move : game.GetValidMoves()) {
+    ::Game::Game next = game;
+    next.DoMove(move);
+    leaves += CountLeaves(next, depth - 1);
+  }
+
+  return leaves;
+}
+
+int Perft() {
+  constexpr size_t depth = 5;
+  constexpr size_t expectedLeaves = 577825;
+
+  const ::Game::Game root(5, 5, Cards);
+
+  size_t leaves = 0;
+  const int result = Measure("perft", [&]() {
+    leaves = CountLeaves(root, depth);
+    return leaves;
+  });
+
+  // A faster move generator is no use if it generates the wrong moves
+  if (leaves != expectedLeaves) {
+    std::cerr << std::format("Expected {} leaves; got {}!", expectedLeaves,
+                             leaves)
+              << std::endl;
+    return Fail;
+  }
+
+  return result;
+}
+
+int RetrogradeAnalysis() {
+  constexpr size_t analysisCount = 1000;
+
+  std::vector<::StateGraph::Graph> graphs;
+  graphs.reserve(analysisCount);
+
+  return Measure(
+      "retrograde analysis",
+      [&]() {
+        for (::StateGraph::Graph& graph : graphs) {
+          ::StateGraph::Strategies::RetrogradeAnalyse(graph);
+        }
+
+        return analysisCount;
+      },
+      [&]() {
+        graphs.clear();
+        for (size_t i = 0; i < analysisCount; i++) {
+          graphs.push_back(
+              ::StateGraph::Graph::Load("./tests/resources/load.graph").first);
+        }
+      });
+}
+
+int RandomGames() {
+  constexpr size_t gameCount = 200;
+  constexpr size_t maxPlies = 200;
+  constexpr uint32_t seed = 0;
+
+  return Measure("random games", [&]() {
+    std::mt19937 generator(seed);
+
+    size_t plies = 0;
+    for (size_t i = 0; i < gameCount; i++) {
+      ::Game::Game game(5, 5, Cards);
+      for (size_t ply = 0; ply < maxPlies && !game.IsFinished().has_value();
+           ply++) {
+        const std::vector<Move>& moves = game.GetValidMoves();
+        game.DoMove(moves[std::uniform_int_distribution<size_t>(
+            0, moves.size() - 1)(generator)]);
+        plies++;
+      }
+    }
+
+    return plies;
+  });
+}
+
+}  // namespace Performance
+}  // namespace Tests
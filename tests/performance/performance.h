@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Tests {
+namespace Performance {
+
+int Perft();
+int RetrogradeAnalysis();
+int RandomGames();
+
+}  // namespace Performance
+}  // namespace Tests
@@ -0,0 +1,165 @@
+#include "positionDatabase.h"
+
+#include <format>
+#include <iostream>
+
+#include "../../src/gameRecord/gameRecord.h"
+#include "../../src/positionDatabase/positionDatabase.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace PositionDatabase {
+
+using namespace ::PositionDatabase;
+
+static constexpr std::array<Game::Card, CARD_COUNT> TemplateCards = {
+    Game::Card(Game::CardType::Boar), Game::Card(Game::CardType::Ox),
+    Game::Card(Game::CardType::Crab), Game::Card(Game::CardType::Tiger),
+    Game::Card(Game::CardType::Goose)};
+
+static const std::filesystem::path RecordPath =
+    "./tests/Tests_PositionDatabase_records";
+
+static std::unique_ptr<const Game::Game> TemplateGame;
+
+// Three games starting with the first valid move, won by red, blue and
+// drawn, and one starting with the second valid move, won by red
+static std::vector<::GameRecord::Record> TemplateRecords;
+
+void Init() {
+  TemplateGame = std::make_unique<const Game::Game>(3, 3, TemplateCards);
+
+  TemplateRecords.clear();
+  const std::vector<std::pair<size_t, std::optional<Color>>> games = {
+      {0, Color::Red}, {0, Color::Blue}, {0, std::nullopt}, {1, Color::Red}};
+  for (const auto& [firstMove, winner] : games) {
+    Game::Game game(*TemplateGame);
+    ::GameRecord::Record record{.Dimensions = game.GetDimensions(),
+                                .Cards = TemplateCards,
+                                .Winner = winner};
+
+    record.Moves.push_back(game.GetValidMoves()[firstMove]);
+    game.DoMove(record.Moves.back());
+    record.Moves.push_back(game.GetValidMoves()[0]);
+
+    TemplateRecords.push_back(record);
+  }
+}
+
+static bool WriteRecords() {
+  std::unique_ptr<::GameRecord::Writer> writer =
+      ::GameRecord::Writer::Open(RecordPath);
+  if (writer == nullptr) return false;
+
+  for (const ::GameRecord::Record& record : TemplateRecords) {
+    writer->Write(record);
+  }
+  return writer->Flush();
+}
+
+int Build() {
+  const std::filesystem::path outPath =
+      "./tests/Tests_PositionDatabase_Build_output";
+  if (!WriteRecords()) return Fail;
+
+  // A run size of one ply forces a run per game, to be merged
+  const std::optional<BuildInfo> info = ::PositionDatabase::Build(
+      {RecordPath, RecordPath}, outPath, 2, 1);
+  std::filesystem::remove(RecordPath);
+
+  if (!info) {
+    std::filesystem::remove(outPath);
+    std::cerr << "Failed to build the database!" << std::endl;
+    return Fail;
+  }
+
+  std::optional<Database> database = Database::Open(outPath);
+  if (!database) {
+    std::filesystem::remove(outPath);
+    return Fail;
+  }
+
+  const Position root = database->Find(*TemplateGame);
+
+  Game::Game next(*TemplateGame);
+  next.DoMove(TemplateGame->GetValidMoves()[0]);
+  const Position reply = database->Find(next);
+  std::filesystem::remove(outPath);
+
+  if (info->GameCount != 8 || info->RunCount != 8 || info->PlyCount != 16) {
+    std::cerr << std::format("Expected 8 games and runs and 16 plies; got "
+                             "{}, {} and {}!",
+                             info->GameCount, info->RunCount, info->PlyCount)
+              << std::endl;
+    return Fail;
+  }
+
+  if (root.Moves.size() != 2 || root.GetVisits() != 8) {
+    std::cerr << std::format("Expected 2 moves and 8 visits; got {} and {}!",
+                             root.Moves.size(), root.GetVisits())
+              << std::endl;
+    return Fail;
+  }
+
+  const uint16_t firstMove = TemplateGame->GetValidMoves()[0].Pack();
+  for (const Entry& entry : root.Moves) {
+    const bool isFirst = entry.Move == firstMove;
+    const std::array<uint32_t, 3> expected =
+        isFirst ? std::array<uint32_t, 3>{2, 2, 2}
+                : std::array<uint32_t, 3>{2, 0, 0};
+    const std::array<uint32_t, 3> actual = {entry.Wins, entry.Draws,
+                                            entry.Losses};
+    if (actual != expected) {
+      std::cerr << std::format("Unexpected results {}-{}-{} for a root move!",
+                               entry.Wins, entry.Draws, entry.Losses)
+                << std::endl;
+      return Fail;
+    }
+  }
+
+  // The reply is scored from blue's point of view
+  if (reply.Moves.size() != 1 || reply.Moves[0].Wins != 2 ||
+      reply.Moves[0].Draws != 2 || reply.Moves[0].Losses != 2) {
+    std::cerr << "Unexpected results for the reply!" << std::endl;
+    return Fail;
+  }
+
+  if (!database->Find(Game::Game(5, 5, TemplateCards)).Moves.empty()) {
+    std::cerr << "Found an unrecorded position!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int GetBestMove() {
+  const Game::Move first = TemplateGame->GetValidMoves()[0];
+  const Game::Move second = TemplateGame->GetValidMoves()[1];
+
+  const Position position{.Moves = {
+                              Entry{.Move = first.Pack(), .Wins = 3,
+                                    .Draws = 2, .Losses = 1},
+                              Entry{.Move = second.Pack(), .Wins = 1},
+                          }};
+
+  if (position.GetBestMove(1) != second) {
+    std::cerr << "Expected the move with the highest score!" << std::endl;
+    return Fail;
+  }
+
+  if (position.GetBestMove(2) != first) {
+    std::cerr << "Expected moves with too few visits to be ignored!"
+              << std::endl;
+    return Fail;
+  }
+
+  if (position.GetBestMove(7)) {
+    std::cerr << "Expected no move to have enough visits!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+}  // namespace PositionDatabase
+}  // namespace Tests
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Tests {
+namespace PositionDatabase {
+
+void Init();
+
+int Build();
+int GetBestMove();
+
+}  // namespace PositionDatabase
+}  // namespace Tests
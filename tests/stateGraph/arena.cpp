@@ -0,0 +1,201 @@
+#include "arena.h"
+
+#include <future>
+#include <iostream>
+
+#include "../../src/stateGraph/arena.h"
+#include "../../src/stateGraph/strategies.h"
+#include "../../src/util/base64.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace StateGraph {
+namespace Arena {
+
+using namespace ::StateGraph;
+
+int Allocate() {
+  ::StateGraph::Arena arena;
+  if (arena.GetReservedBytes() != 0) {
+    std::cerr << "Empty arena reserved memory!" << std::endl;
+    return Fail;
+  }
+
+  char* previous = static_cast<char*>(arena.Allocate(1, 1));
+  for (const size_t alignment : {1, 2, 4, 8, 16}) {
+    char* memory = static_cast<char*>(arena.Allocate(24, alignment));
+
+    if (reinterpret_cast<uintptr_t>(memory) % alignment != 0) {
+      std::cerr << std::format("Allocation is not aligned to {} bytes!",
+                               alignment)
+                << std::endl;
+      return Fail;
+    }
+
+    if (memory <= previous) {
+      std::cerr << "Allocations overlap!" << std::endl;
+      return Fail;
+    }
+
+    previous = memory + 23;
+  }
+
+  if (arena.GetReservedBytes() != ARENA_BLOCK_SIZE) {
+    std::cerr << std::format("Expected one block of {} bytes; got {} bytes!",
+                             ARENA_BLOCK_SIZE, arena.GetReservedBytes())
+              << std::endl;
+    return Fail;
+  }
+
+  // Oversized allocations get a block of their own
+  arena.Allocate(ARENA_BLOCK_SIZE + 1, 8);
+  if (arena.GetReservedBytes() != ARENA_BLOCK_SIZE * 3) {
+    std::cerr << std::format("Expected {} bytes for an oversized block; got "
+                             "{} bytes!",
+                             ARENA_BLOCK_SIZE * 3, arena.GetReservedBytes())
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int Threads() {
+  constexpr size_t threadCount = 4;
+  constexpr size_t allocationCount = 100000;
+
+  ::StateGraph::Arena arena;
+
+  // Each thread marks its allocations with its own id, which another thread
+  // handed the same memory would overwrite
+  std::vector<std::future<std::vector<size_t*>>> threads;
+  for (size_t threadId = 0; threadId < threadCount; threadId++) {
+    threads.emplace_back(std::async(std::launch::async, [&arena, threadId] {
+      std::vector<size_t*> allocations;
+      allocations.reserve(allocationCount);
+      for (size_t i = 0; i < allocationCount; i++) {
+        size_t* memory = static_cast<size_t*>(
+            arena.Allocate(sizeof(size_t), alignof(size_t)));
+        *memory = threadId;
+        allocations.push_back(memory);
+      }
+
+      return allocations;
+    }));
+  }
+
+  for (size_t threadId = 0; threadId < threadCount; threadId++) {
+    for (const size_t* memory : threads[threadId].get()) {
+      if (*memory != threadId) {
+        std::cerr << "Threads were handed the same memory!" << std::endl;
+        return Fail;
+      }
+    }
+  }
+
+  return Pass;
+}
+
+int Detach() {
+  constexpr size_t threadCount = 8;
+
+  ::StateGraph::Arena arena;
+
+  // Threads that come one after another share a block, having handed it on
+  size_t* previous = nullptr;
+  for (size_t threadId = 0; threadId < threadCount; threadId++) {
+    size_t* memory = std::async(std::launch::async, [&arena] {
+                       void* memory =
+                           arena.Allocate(sizeof(size_t), alignof(size_t));
+                       arena.Detach();
+                       return static_cast<size_t*>(memory);
+                     }).get();
+
+    if (previous != nullptr && memory <= previous) {
+      std::cerr << "Thread was handed used memory!" << std::endl;
+      return Fail;
+    }
+    previous = memory;
+  }
+
+  if (arena.GetReservedBytes() != ARENA_BLOCK_SIZE) {
+    std::cerr << std::format("Expected one block of {} bytes; got {} bytes!",
+                             ARENA_BLOCK_SIZE, arena.GetReservedBytes())
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+static Graph Explore() {
+  Graph graph;
+  Strategies::ExploreComponent(
+      graph,
+      ::Game::Game::FromSerialization(
+          Base64::Decode<::Game::GAME_SERIALIZATION_SIZE>("goIDQAAB").value()),
+      0);
+  return graph;
+}
+
+static int CompareGraph(const Graph& graph, const Graph& expected) {
+  if (graph.GetNodeCount() != expected.GetNodeCount() ||
+      graph.GetEdgeCount() != expected.GetEdgeCount()) {
+    std::cerr << std::format("Expected {} vertices and {} edges; got {} and {}!",
+                             expected.GetNodeCount(), expected.GetEdgeCount(),
+                             graph.GetNodeCount(), graph.GetEdgeCount())
+              << std::endl;
+    return Fail;
+  }
+
+  for (const auto& [_, vertex] : graph.Vertices) {
+    for (const std::shared_ptr<Edge>& edge : vertex->Edges) {
+      if (edge->Source.lock() != vertex || edge->Target.expired()) {
+        std::cerr << "Edge lost its vertices!" << std::endl;
+        return Fail;
+      }
+    }
+  }
+
+  return Pass;
+}
+
+int GraphAssignment() {
+  const Graph expected = Explore();
+
+  // Assigning into a populated graph releases its vertices before the arena
+  // they live in
+  Graph graph = Explore();
+  std::weak_ptr<::StateGraph::Arena> previousArena = graph.Objects;
+  graph = expected;
+  if (!previousArena.expired() || graph.Objects != expected.Objects) {
+    std::cerr << "Copy assignment kept the previous arena!" << std::endl;
+    return Fail;
+  }
+  if (CompareGraph(graph, expected)) return Fail;
+
+  graph = Explore();
+  previousArena = graph.Objects;
+  graph = Graph();
+  if (!previousArena.expired() || !graph.Vertices.empty()) {
+    std::cerr << "Move assignment kept the previous graph!" << std::endl;
+    return Fail;
+  }
+
+  graph = Explore();
+  previousArena = graph.Objects;
+  Graph replacement = Explore();
+  const ::StateGraph::Arena* replacementArena = replacement.Objects.get();
+  graph = std::move(replacement);
+  if (!previousArena.expired() || graph.Objects.get() != replacementArena) {
+    std::cerr << "Move assignment kept the previous arena!" << std::endl;
+    return Fail;
+  }
+  if (CompareGraph(graph, expected)) return Fail;
+
+  return Pass;
+}
+
+}  // namespace Arena
+}  // namespace StateGraph
+}  // namespace Tests
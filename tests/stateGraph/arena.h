@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Tests {
+namespace StateGraph {
+namespace Arena {
+
+int Allocate();
+int Threads();
+int Detach();
+int GraphAssignment();
+
+}  // namespace Arena
+}  // namespace StateGraph
+}  // namespace Tests
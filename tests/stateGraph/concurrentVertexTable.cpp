@@ -0,0 +1,185 @@
+#include "concurrentVertexTable.h"
+
+#include <algorithm>
+#include <future>
+
+#include "../../src/stateGraph/concurrentVertexTable.h"
+#include "../../src/stateGraph/strategies.h"
+#include "../../src/util/base64.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace StateGraph {
+namespace ConcurrentVertexTable {
+
+using namespace ::StateGraph;
+using namespace ::Game;
+
+static ::Game::Game Deserialize(const std::string& serialization) {
+  return ::Game::Game::FromSerialization(
+      Base64::Decode<GAME_SERIALIZATION_SIZE>(serialization).value());
+}
+
+int Claim() {
+  constexpr size_t threadCount = 4;
+
+  // The games two moves into a 2x5 game, with duplicates included
+  std::vector<::Game::Game> games;
+  const ::Game::Game root = Deserialize("BBIIFQAAB");
+  for (const Move move : root.GetValidMoves()) {
+    ::Game::Game child(root);
+    child.DoMove(move);
+    for (const Move nextMove : child.GetValidMoves()) {
+      ::Game::Game grandchild(child);
+      grandchild.DoMove(nextMove);
+      games.push_back(std::move(grandchild));
+    }
+  }
+
+  Graph graph;
+  ::StateGraph::ConcurrentVertexTable vertices(graph);
+
+  // Every thread tries to claim every game, so that each claim is contested
+  std::vector<std::future<size_t>> threads;
+  for (size_t threadId = 0; threadId < threadCount; threadId++) {
+    threads.emplace_back(std::async(std::launch::async, [&vertices, &games] {
+      size_t claims = 0;
+      for (const ::Game::Game& game : games) {
+        if (vertices.Claim(game).second) claims++;
+      }
+      return claims;
+    }));
+  }
+
+  size_t claims = 0;
+  for (std::future<size_t>& thread : threads) claims += thread.get();
+
+  if (claims != vertices.size()) {
+    std::cerr << std::format("Expected {} claims; got {}!", vertices.size(),
+                             claims)
+              << std::endl;
+    return Fail;
+  }
+
+  for (const ::Game::Game& game : games) {
+    if (!vertices.IsClaimed(game)) {
+      std::cerr << "Claimed vertex is not claimed!" << std::endl;
+      return Fail;
+    }
+
+    const auto [vertex, claimed] = vertices.Insert(game);
+    if (!claimed || *vertex != game) {
+      std::cerr << "Inserting a claimed game changed its vertex!" << std::endl;
+      return Fail;
+    }
+  }
+
+  return Pass;
+}
+
+int TakeRelease() {
+  Graph graph;
+  Strategies::ExploreComponent(graph, Deserialize("goIDQAAB"), 0);
+
+  // Leave one vertex unexpanded
+  const std::shared_ptr<Vertex> unexpanded =
+      std::find_if(graph.Vertices.begin(), graph.Vertices.end(),
+                   [](const VertexTable::Entry& entry) {
+                     return !entry.second->Quality.has_value() &&
+                            !entry.second->Edges.empty();
+                   })
+          ->second;
+  unexpanded->Edges.clear();
+
+  std::vector<std::shared_ptr<Vertex>> expected;
+  for (const auto& [key, vertex] : graph.Vertices) expected.push_back(vertex);
+
+  ::StateGraph::ConcurrentVertexTable vertices(graph);
+  if (!graph.Vertices.empty()) {
+    std::cerr << "Graph kept its vertices!" << std::endl;
+    return Fail;
+  }
+
+  for (const std::shared_ptr<Vertex>& vertex : expected) {
+    const ::Game::Game game =
+        ::Game::Game::FromSerialization(vertex->Serialization);
+    const bool shouldBeClaimed = vertex != unexpanded;
+
+    if (vertices.IsClaimed(game) != shouldBeClaimed) {
+      std::cerr << std::format("Expected vertex to be {}claimed!",
+                               shouldBeClaimed ? "" : "un")
+                << std::endl;
+      return Fail;
+    }
+
+    if (vertices.Insert(game).first != vertex) {
+      std::cerr << "Vertex was replaced!" << std::endl;
+      return Fail;
+    }
+  }
+
+  vertices.Release();
+  if (graph.Vertices.size() != expected.size()) {
+    std::cerr << std::format("Expected {} vertices; got {}!", expected.size(),
+                             graph.Vertices.size())
+              << std::endl;
+    return Fail;
+  }
+
+  for (const std::shared_ptr<Vertex>& vertex : expected) {
+    const ::Game::Game game =
+        ::Game::Game::FromSerialization(vertex->Serialization);
+    if (graph.Vertices.at(game) != vertex) {
+      std::cerr << "Vertex was replaced!" << std::endl;
+      return Fail;
+    }
+  }
+
+  return Pass;
+}
+
+int DispersedFrontier() {
+  constexpr size_t depth = 2;
+  constexpr size_t threadCount = 4;
+
+  for (const std::string serialization :
+       {"QYICQAAB", "goIDQAAB", "BBIIFQAAB"}) {
+    const ::Game::Game game = Deserialize(serialization);
+
+    Graph expected;
+    Strategies::ExploreComponent(expected, game, 0);
+    Strategies::RetrogradeAnalyse(expected);
+
+    Graph actual;
+    Strategies::DispersedFrontier(actual, game, depth, threadCount);
+
+    if (actual.GetNodeCount() != expected.GetNodeCount() ||
+        actual.GetEdgeCount() != expected.GetEdgeCount()) {
+      std::cerr << std::format(
+                       "Expected {} vertices and {} edges; got {} and {}!",
+                       expected.GetNodeCount(), expected.GetEdgeCount(),
+                       actual.GetNodeCount(), actual.GetEdgeCount())
+                << std::endl;
+      return Fail;
+    }
+
+    for (const auto& [key, expectedVertex] : expected.Vertices) {
+      const auto actualVertex = actual.Vertices.find(key);
+      if (actualVertex == actual.Vertices.end()) {
+        std::cerr << "Vertex went missing!" << std::endl;
+        return Fail;
+      }
+
+      if (actualVertex->second->Quality != expectedVertex->Quality) {
+        std::cerr << "Vertex quality differs!" << std::endl;
+        return Fail;
+      }
+    }
+  }
+
+  return Pass;
+}
+
+}  // namespace ConcurrentVertexTable
+}  // namespace StateGraph
+}  // namespace Tests
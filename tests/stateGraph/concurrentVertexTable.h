@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Tests {
+namespace StateGraph {
+namespace ConcurrentVertexTable {
+
+int Claim();
+int TakeRelease();
+int DispersedFrontier();
+
+}  // namespace ConcurrentVertexTable
+}  // namespace StateGraph
+}  // namespace Tests
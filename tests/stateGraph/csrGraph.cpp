@@ -0,0 +1,212 @@
+#include "csrGraph.h"
+
+#include "../../src/stateGraph/csrGraph.h"
+#include "../../src/stateGraph/strategies.h"
+#include "../../src/util/base64.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace StateGraph {
+namespace CsrGraph {
+
+using namespace ::StateGraph;
+using namespace ::Game;
+
+static Graph Explore(const std::string& serialization) {
+  const ::Game::Game game = ::Game::Game::FromSerialization(
+      Base64::Decode<GAME_SERIALIZATION_SIZE>(serialization).value());
+
+  Graph graph;
+  Strategies::ExploreComponent(graph, game, 0);
+  return graph;
+}
+
+// Checks that both graphs hold the same vertices, with the same qualities
+// and the same labelled edges
+static std::optional<std::string> Compare(const Graph& expected,
+                                          const Graph& actual) {
+  if (actual.Vertices.size() != expected.Vertices.size())
+    return std::format("Expected {} vertices; got {}!",
+                       expected.Vertices.size(), actual.Vertices.size());
+
+  for (const auto& [game, expectedVertex] : expected.Vertices) {
+    const std::optional<std::weak_ptr<const Vertex>> actualVertexPtr =
+        actual.Get(game);
+    if (!actualVertexPtr.has_value()) return "Vertex went missing!";
+    const std::shared_ptr<const Vertex> actualVertex = actualVertexPtr->lock();
+
+    if (actualVertex->Serialization != expectedVertex->Serialization)
+      return "Vertex serialization changed!";
+
+    if (actualVertex->Quality != expectedVertex->Quality)
+      return "Vertex quality changed!";
+
+    if (actualVertex->Edges.size() != expectedVertex->Edges.size())
+      return "Vertex edge count changed!";
+
+    for (size_t i = 0; i < expectedVertex->Edges.size(); i++) {
+      const Edge& expectedEdge = *expectedVertex->Edges[i];
+      const Edge& actualEdge = *actualVertex->Edges[i];
+
+      if (actualEdge.Move != expectedEdge.Move) return "Edge move changed!";
+
+      if (actualEdge.Optimal != expectedEdge.Optimal)
+        return "Edge label changed!";
+
+      if (actualEdge.Source.lock() != actualVertex)
+        return "Edge source is not its vertex!";
+
+      const std::shared_ptr<const Vertex> actualTarget =
+          actualEdge.Target.lock();
+      if (actualTarget == nullptr) return "Edge target was deleted!";
+
+      if (actualTarget->Serialization !=
+          expectedEdge.Target.lock()->Serialization)
+        return "Edge target changed!";
+    }
+  }
+
+  return std::nullopt;
+}
+
+int FromGraph() {
+  const Graph graph = Explore("goIDQAAB");
+  const ::StateGraph::CsrGraph csr = ::StateGraph::CsrGraph::FromGraph(graph);
+
+  if (csr.GetVertexCount() != graph.Vertices.size()) {
+    std::cerr << std::format("Expected {} vertices; got {}!",
+                             graph.Vertices.size(), csr.GetVertexCount())
+              << std::endl;
+    return Fail;
+  }
+
+  if (csr.GetEdgeCount() != graph.GetEdgeCount()) {
+    std::cerr << std::format("Expected {} edges; got {}!",
+                             graph.GetEdgeCount(), csr.GetEdgeCount())
+              << std::endl;
+    return Fail;
+  }
+
+  for (VertexId vertex = 0; vertex < csr.GetVertexCount(); vertex++) {
+    const std::shared_ptr<const Vertex> original =
+        graph.Get(::Game::Game::FromSerialization(csr.Serializations[vertex]))
+            ->lock();
+
+    if (csr.GetEdgesEnd(vertex) - csr.GetEdgesBegin(vertex) !=
+        original->Edges.size()) {
+      std::cerr << "Vertex edge count changed!" << std::endl;
+      return Fail;
+    }
+
+    for (size_t i = 0; i < original->Edges.size(); i++) {
+      const EdgeId edge = csr.GetEdgesBegin(vertex) + i;
+
+      if (Move::Unpack(csr.Moves[edge]) != original->Edges[i]->Move) {
+        std::cerr << "Edge move changed!" << std::endl;
+        return Fail;
+      }
+
+      if (csr.Serializations[csr.Targets[edge]] !=
+          original->Edges[i]->Target.lock()->Serialization) {
+        std::cerr << "Edge target changed!" << std::endl;
+        return Fail;
+      }
+
+      if (csr.Labels[edge] != EdgeLabel::Unlabelled) {
+        std::cerr << "Unanalysed edge was labelled!" << std::endl;
+        return Fail;
+      }
+    }
+  }
+
+  return Pass;
+}
+
+int ToGraph() {
+  Graph graph = Explore("goIDQAAB");
+  Strategies::RetrogradeAnalyse(graph);
+
+  const Graph roundTrip =
+      ::StateGraph::CsrGraph::FromGraph(graph).ToGraph();
+
+  const std::optional<std::string> message = Compare(graph, roundTrip);
+  if (message.has_value()) {
+    std::cerr << message.value() << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int RetrogradeAnalyse() {
+  const std::array<std::pair<std::string, WinState>, 3> cases = {
+      std::make_pair("QYICQAAB", WinState::Win),
+      std::make_pair("goIDQAAB", WinState::Lose),
+      std::make_pair("BBIIFQAAB", WinState::Draw),
+  };
+
+  for (const auto& [serialization, expectedQuality] : cases) {
+    Graph expected = Explore(serialization);
+    ::StateGraph::CsrGraph csr = ::StateGraph::CsrGraph::FromGraph(expected);
+    Strategies::RetrogradeAnalyse(expected);
+    Strategies::RetrogradeAnalyse(csr);
+    const Graph actual = csr.ToGraph();
+
+    const ::Game::Game root = ::Game::Game::FromSerialization(
+        Base64::Decode<GAME_SERIALIZATION_SIZE>(serialization).value());
+    const std::optional<WinState> quality = actual.Get(root)->lock()->Quality;
+    if (quality != expectedQuality) {
+      const std::string winString =
+          quality.has_value() ? to_string(quality.value()) : "Unknown";
+      std::cerr << std::format("{}: expected {} for Red; got {}!",
+                               serialization, to_string(expectedQuality),
+                               winString)
+                << std::endl;
+      return Fail;
+    }
+
+    // The solvers visit vertices in different orders, so only the
+    // qualities have to agree, not which of several moves is optimal
+    for (const auto& [game, expectedVertex] : expected.Vertices) {
+      const std::shared_ptr<const Vertex> actualVertex =
+          actual.Get(game)->lock();
+
+      if (actualVertex->Quality != expectedVertex->Quality) {
+        std::cerr << std::format("{}: vertex quality differs from the "
+                                 "pointer-based analysis!",
+                                 serialization)
+                  << std::endl;
+        return Fail;
+      }
+
+      if (actualVertex->Edges.empty() || !actualVertex->Quality.has_value())
+        continue;
+
+      const auto optimalEdgeIt = std::find_if(
+          actualVertex->Edges.begin(), actualVertex->Edges.end(),
+          [](const std::shared_ptr<Edge> edge) { return edge->IsOptimal(); });
+      if (optimalEdgeIt == actualVertex->Edges.end()) {
+        std::cerr << std::format("{}: labelled vertex has no optimal move!",
+                                 serialization)
+                  << std::endl;
+        return Fail;
+      }
+
+      const std::optional<WinState> targetQuality =
+          (*optimalEdgeIt)->Target.lock()->Quality;
+      if (targetQuality != -actualVertex->Quality.value()) {
+        std::cerr << std::format("{}: optimal move does not lead to the "
+                                 "opposite quality!",
+                                 serialization)
+                  << std::endl;
+        return Fail;
+      }
+    }
+  }
+
+  return Pass;
+}
+
+}  // namespace CsrGraph
+}  // namespace StateGraph
+}  // namespace Tests
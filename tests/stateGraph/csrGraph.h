@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Tests {
+namespace StateGraph {
+namespace CsrGraph {
+
+int FromGraph();
+int ToGraph();
+int RetrogradeAnalyse();
+
+}  // namespace CsrGraph
+}  // namespace StateGraph
+}  // namespace Tests
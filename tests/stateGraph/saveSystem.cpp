@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "../../src/stateGraph/strategies.h"
 #include "../../src/util/base64.h"
 #include "../assertEqual.h"
 
@@ -478,5 +479,91 @@ int Load() {
   return Pass;
 }
 
+// Compares the vertices, edge counts and qualities of two graphs
+static int CompareResumed(const Graph& graph, const Graph& expected) {
+  if (graph.GetNodeCount() != expected.GetNodeCount() ||
+      graph.GetEdgeCount() != expected.GetEdgeCount()) {
+    std::cerr << std::format("Expected {} vertices and {} edges; got {} and {}!",
+                             expected.GetNodeCount(), expected.GetEdgeCount(),
+                             graph.GetNodeCount(), graph.GetEdgeCount())
+              << std::endl;
+    return Fail;
+  }
+
+  for (const auto& [key, expectedVertex] : expected.Vertices) {
+    const auto vertex = graph.Vertices.find(key);
+    if (vertex == graph.Vertices.end()) {
+      std::cerr << std::format("Missing vertex \"{}\"!",
+                               Base64::Encode(expectedVertex->Serialization))
+                << std::endl;
+      return Fail;
+    }
+
+    if (vertex->second->Edges.size() != expectedVertex->Edges.size() ||
+        vertex->second->Quality != expectedVertex->Quality) {
+      std::cerr << std::format("Vertex \"{}\" differs from an uninterrupted "
+                               "run!",
+                               Base64::Encode(expectedVertex->Serialization))
+                << std::endl;
+      return Fail;
+    }
+  }
+
+  return Pass;
+}
+
+int Resume() {
+  const std::filesystem::path path = "./tests/Tests_StateGraph_Resume_output";
+  constexpr size_t frontierDepth = 2;
+  constexpr size_t threadCount = 2;
+
+  for (const std::string serialization : {"goIDQAAB", "BBIIFQAAB"}) {
+    const Game::Game game = Game::Game::FromSerialization(
+        Base64::Decode<Game::GAME_SERIALIZATION_SIZE>(serialization).value());
+
+    Graph expectedComponent;
+    Strategies::ExploreComponent(expectedComponent, game, 0);
+
+    Graph expectedDispersed;
+    Strategies::DispersedFrontier(expectedDispersed, game, frontierDepth,
+                                  threadCount);
+
+    for (const size_t stopAfter : {1, 5, 50}) {
+      // Stop after a number of checks, then resume from the saved graph
+      size_t checks = 0;
+      const std::function<bool()> shouldStop = [&checks, stopAfter] {
+        return ++checks > stopAfter;
+      };
+
+      Graph component;
+      Strategies::ExploreComponent(component, game, 0, std::nullopt,
+                                   shouldStop);
+      if (component.GetNodeCount() >= expectedComponent.GetNodeCount()) {
+        std::cerr << "Component was not stopped early!" << std::endl;
+        return Fail;
+      }
+
+      component.Save(path);
+      component = Graph::Load(path).first;
+      Strategies::ExploreComponent(component, game, 0);
+      if (CompareResumed(component, expectedComponent)) return Fail;
+
+      checks = 0;
+      Graph dispersed;
+      Strategies::DispersedFrontier(dispersed, game, frontierDepth,
+                                    threadCount, std::nullopt, shouldStop);
+
+      dispersed.Save(path);
+      dispersed = Graph::Load(path).first;
+      Strategies::DispersedFrontier(dispersed, game, frontierDepth,
+                                    threadCount);
+      if (CompareResumed(dispersed, expectedDispersed)) return Fail;
+    }
+  }
+
+  std::filesystem::remove(path);
+  return Pass;
+}
+
 }  // namespace StateGraph
 }  // namespace Tests
@@ -7,6 +7,7 @@ namespace StateGraph {
 
 int Save();
 int Load();
+int Resume();
 
 }  // namespace StateGraph
 }  // namespace Tests
@@ -0,0 +1,219 @@
+#include "vertexTable.h"
+
+#include "../../src/stateGraph/stateGraph.h"
+#include "../../src/util/base64.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace StateGraph {
+namespace VertexTable {
+
+using namespace ::StateGraph;
+
+// Games reached by playing every move from a 2x3 and a 2x5 game, each
+// alongside its mirror image, with duplicates included
+static std::vector<::Game::Game> Games;
+
+// Turns the board around, swaps the colours and reverses the hands, which
+// EqualTo considers the same game only with symmetries
+static ::Game::Game Mirror(const ::Game::Game& game) {
+  const auto [width, height] = game.GetDimensions();
+  const std::span<const ::Game::Tile> grid = game.GetBoard().GetGrid();
+
+  std::vector<::Game::Tile> mirroredGrid(grid.rbegin(), grid.rend());
+  for (::Game::Tile& tile : mirroredGrid) {
+    if (tile) tile->Team = ~tile->Team;
+  }
+
+  const std::span<const ::Game::Card, CARD_COUNT> cards = game.GetCards();
+  return ::Game::Game(::Game::Board(mirroredGrid, width, height),
+                      {cards[0], cards[4], cards[3], cards[2], cards[1]},
+                      ~game.GetCurrentPlayer());
+}
+
+void Init() {
+  constexpr size_t maxDepth = 3;
+
+  for (const std::string serialization : {"goIDQAAB", "BBIIFQAAB"}) {
+    std::vector<::Game::Game> layer = {::Game::Game::FromSerialization(
+        Base64::Decode<::Game::GAME_SERIALIZATION_SIZE>(serialization)
+            .value())};
+
+    for (size_t depth = 0; depth <= maxDepth; depth++) {
+      std::vector<::Game::Game> nextLayer;
+      for (const ::Game::Game& game : layer) {
+        Games.push_back(game);
+        Games.push_back(Mirror(game));
+
+        for (const ::Game::Move move : game.GetValidMoves()) {
+          ::Game::Game next(game);
+          next.DoMove(move);
+          nextLayer.push_back(std::move(next));
+        }
+      }
+
+      layer = std::move(nextLayer);
+    }
+  }
+}
+
+static int CompareKeys() {
+  std::vector<::Game::PositionKey> keys;
+  keys.reserve(Games.size());
+  for (const ::Game::Game& game : Games)
+    keys.push_back(::StateGraph::VertexTable::GetKey(game));
+
+  for (size_t firstId = 0; firstId < Games.size(); firstId++) {
+    const ::Game::Game& first = Games[firstId];
+    const ::Game::PositionKey firstKey = keys[firstId];
+
+    // The key is itself the serialization of an equal game
+    const ::Game::Game keyGame =
+        ::Game::Game::FromSerialization(firstKey.ToSerialization());
+    if (!EqualTo()(first, keyGame)) {
+      std::cerr << std::format("Key of \"{}\" is not an equal game!",
+                               Base64::Encode(first.Serialize()))
+                << std::endl;
+      return Fail;
+    }
+
+    for (size_t secondId = 0; secondId < Games.size(); secondId++) {
+      const ::Game::Game& second = Games[secondId];
+      const bool equal = EqualTo()(first, second);
+      const bool equalKeys = firstKey == keys[secondId];
+
+      if (equal != equalKeys) {
+        std::cerr << std::format(
+                         "Games \"{}\" and \"{}\" are {}equal, but their keys "
+                         "are {}equal!",
+                         Base64::Encode(first.Serialize()),
+                         Base64::Encode(second.Serialize()),
+                         equal ? "" : "not ", equalKeys ? "" : "not ")
+                  << std::endl;
+        return Fail;
+      }
+    }
+  }
+
+  return Pass;
+}
+
+int GetKey() {
+  UseSymmetries = true;
+  const int symmetricResult = CompareKeys();
+
+  UseSymmetries = false;
+  const int asymmetricResult = CompareKeys();
+
+  UseSymmetries = true;
+  return symmetricResult == Pass && asymmetricResult == Pass ? Pass : Fail;
+}
+
+int Emplace() {
+  ::StateGraph::VertexTable table;
+  std::vector<::Game::Game> distinct;
+
+  for (const ::Game::Game& game : Games) {
+    const std::shared_ptr<Vertex> vertex = std::make_shared<Vertex>(game);
+    const auto [entry, inserted] = table.emplace(game, vertex);
+
+    const bool isNew = std::none_of(
+        distinct.begin(), distinct.end(),
+        [&game](const ::Game::Game& other) { return EqualTo()(game, other); });
+    if (isNew) distinct.push_back(game);
+
+    if (inserted != isNew) {
+      std::cerr << std::format("Expected the vertex to be {}inserted!",
+                               isNew ? "" : "not ")
+                << std::endl;
+      return Fail;
+    }
+
+    const ::Game::Game entryGame =
+        ::Game::Game::FromSerialization(entry->second->Serialization);
+    if (!EqualTo()(entryGame, game)) {
+      std::cerr << "Emplacing returned the entry of another game!" << std::endl;
+      return Fail;
+    }
+  }
+
+  if (table.size() != distinct.size()) {
+    std::cerr << std::format("Expected {} vertices; got {}!", distinct.size(),
+                             table.size())
+              << std::endl;
+    return Fail;
+  }
+
+  const size_t iterated = std::distance(table.begin(), table.end());
+  if (iterated != table.size()) {
+    std::cerr << std::format("Iterated over {} of {} vertices!", iterated,
+                             table.size())
+              << std::endl;
+    return Fail;
+  }
+
+  for (const ::Game::Game& game : distinct) {
+    if (!table.contains(game) ||
+        table.at(game)->Serialization != game.Serialize()) {
+      std::cerr << std::format("Lost vertex \"{}\"!",
+                               Base64::Encode(game.Serialize()))
+                << std::endl;
+      return Fail;
+    }
+  }
+
+  const ::Game::PositionKey absentKey{.High = ~uint64_t{0}, .Low = 0};
+  if (table.find(absentKey) != table.end()) {
+    std::cerr << "Found an absent vertex!" << std::endl;
+    return Fail;
+  }
+
+  try {
+    table.at(absentKey);
+    std::cerr << "Looking up an absent vertex did not throw!" << std::endl;
+    return Fail;
+  } catch (const std::out_of_range&) {
+  }
+
+  return Pass;
+}
+
+int Reserve() {
+  constexpr size_t count = 1000;
+
+  ::StateGraph::VertexTable table;
+  table.emplace(Games[0], std::make_shared<Vertex>(Games[0]));
+  table.reserve(count);
+  const size_t capacity = table.capacity();
+
+  if (!table.contains(Games[0])) {
+    std::cerr << "Reserving lost a vertex!" << std::endl;
+    return Fail;
+  }
+
+  for (uint64_t i = 1; i < count; i++) {
+    table.emplace(::Game::PositionKey{.High = i, .Low = i * i}, nullptr);
+  }
+
+  if (table.capacity() != capacity) {
+    std::cerr << std::format(
+                     "Reserved table grew from {} to {} slots for {} "
+                     "vertices!",
+                     capacity, table.capacity(), count)
+              << std::endl;
+    return Fail;
+  }
+
+  for (uint64_t i = 1; i < count; i++) {
+    if (!table.contains(::Game::PositionKey{.High = i, .Low = i * i})) {
+      std::cerr << std::format("Lost key {}!", i) << std::endl;
+      return Fail;
+    }
+  }
+
+  return Pass;
+}
+
+}  // namespace VertexTable
+}  // namespace StateGraph
+}  // namespace Tests
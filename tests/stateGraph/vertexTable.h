@@ -0,0 +1,15 @@
+#pragma once
+
+namespace Tests {
+namespace StateGraph {
+namespace VertexTable {
+
+void Init();
+
+int GetKey();
+int Emplace();
+int Reserve();
+
+}  // namespace VertexTable
+}  // namespace StateGraph
+}  // namespace Tests
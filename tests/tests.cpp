@@ -9,10 +9,21 @@
 
 #include "./game/board.h"
 #include "./game/game.h"
+#include "./gameMaster.h"
+#include "./gameRecord/gameRecord.h"
+#include "./openingBook/openingBook.h"
+#include "./performance/performance.h"
+#include "./positionDatabase/positionDatabase.h"
+#include "./stateGraph/arena.h"
+#include "./stateGraph/concurrentVertexTable.h"
+#include "./stateGraph/csrGraph.h"
 #include "./stateGraph/edge.h"
 #include "./stateGraph/retrogradeAnalysis.h"
 #include "./stateGraph/saveSystem.h"
+#include "./stateGraph/vertexTable.h"
 #include "./stateGraph/vertex.h"
+#include "./util/elo.h"
+#include "./util/sprt.h"
 
 namespace Tests {
 
@@ -70,6 +81,7 @@ const static std::unordered_map<std::string, std::function<int()>,
         {"Game::Game::IsFinished", Game::Game::IsFinished},
         {"Game::Game::DoMove", Game::Game::DoMove},
         {"Game::Game::Serialize", Game::Game::Serialize},
+        {"Game::Game::GetPositionKey", Game::Game::GetPositionKey},
 
         {"Game::Board::InitialStateConstructorEvenWidth",
          Game::Board::InitialStateConstructorEvenWidth},
@@ -91,6 +103,12 @@ const static std::unordered_map<std::string, std::function<int()>,
         {"Game::Board::OnBoard", Game::Board::OnBoard},
         {"Game::Board::IsFinished", Game::Board::IsFinished},
 
+        {"GameMaster::MaxPlies", GameMaster::MaxPlies},
+        {"GameMaster::Repetition", GameMaster::Repetition},
+        {"GameMaster move time", GameMaster::MoveTime},
+        {"GameMaster pondering hit", GameMaster::PonderHit},
+        {"GameMaster pondering join", GameMaster::PonderJoin},
+
         {"StateGraph::Vertex::GameConstructor",
          StateGraph::Vertex::GameConstructor},
         {"StateGraph::Vertex::SerializationConstructor",
@@ -112,11 +130,65 @@ const static std::unordered_map<std::string, std::function<int()>,
 
         {"StateGraph::Graph::Save", StateGraph::Save},
         {"StateGraph::Graph::Load", StateGraph::Load},
+        {"StateGraph::Graph::Resume", StateGraph::Resume},
 
         {"StateGraph::RetrogradeAnalysis::RetrogradeAnalyseEdge",
          StateGraph::RetrogradeAnalysis::RetrogradeAnalyseEdge},
         {"StateGraph::RetrogradeAnalysis::RetrogradeAnalyseGraph",
          StateGraph::RetrogradeAnalysis::RetrogradeAnalyseGraph},
+
+        {"StateGraph::CsrGraph::FromGraph", StateGraph::CsrGraph::FromGraph},
+        {"StateGraph::CsrGraph::ToGraph", StateGraph::CsrGraph::ToGraph},
+        {"StateGraph::CsrGraph::RetrogradeAnalyse",
+         StateGraph::CsrGraph::RetrogradeAnalyse},
+
+        {"StateGraph::VertexTable::GetKey", StateGraph::VertexTable::GetKey},
+        {"StateGraph::VertexTable::Emplace", StateGraph::VertexTable::Emplace},
+        {"StateGraph::VertexTable::Reserve", StateGraph::VertexTable::Reserve},
+
+        {"StateGraph::Arena::Allocate", StateGraph::Arena::Allocate},
+        {"StateGraph::Arena::Threads", StateGraph::Arena::Threads},
+        {"StateGraph::Arena::Detach", StateGraph::Arena::Detach},
+        {"StateGraph::Arena::GraphAssignment",
+         StateGraph::Arena::GraphAssignment},
+
+        {"StateGraph::ConcurrentVertexTable::Claim",
+         StateGraph::ConcurrentVertexTable::Claim},
+        {"StateGraph::ConcurrentVertexTable::TakeRelease",
+         StateGraph::ConcurrentVertexTable::TakeRelease},
+        {"StateGraph::ConcurrentVertexTable::DispersedFrontier",
+         StateGraph::ConcurrentVertexTable::DispersedFrontier},
+
+        {"OpeningBook::Book::SaveLoad", OpeningBook::SaveLoad},
+        {"OpeningBook::Book::Load truncated", OpeningBook::LoadTruncated},
+        {"OpeningBook::Book::Probe", OpeningBook::Probe},
+        {"OpeningBook::Builder::Build", OpeningBook::Build},
+
+        {"GameRecord::Writer and Reader", GameRecord::WriteRead},
+        {"GameRecord::Writer concurrent writes", GameRecord::ConcurrentWrite},
+        {"GameRecord::Reader truncated file", GameRecord::Truncated},
+
+        {"PositionDatabase::Build", PositionDatabase::Build},
+        {"PositionDatabase::Position::GetBestMove",
+         PositionDatabase::GetBestMove},
+
+        {"Elo::FromScore", Elo::FromScore},
+        {"Elo::FromResults", Elo::FromResults},
+
+        {"Sprt::Test bounds", Sprt::Bounds},
+        {"Sprt::Test::GetLogLikelihoodRatio", Sprt::LogLikelihoodRatio},
+        {"Sprt::Test::GetResult", Sprt::GetResult},
+        {"Sprt::Test uniform tally", Sprt::UniformTally},
+};
+
+// Throughput checks, which depend on the load of the machine and are left out
+// of --all
+const static std::unordered_map<std::string, std::function<int()>,
+                                CaseInsensitiveHash, CaseInsensitiveEqual>
+    PerformanceTests = {
+        {"Performance::Perft", Performance::Perft},
+        {"Performance::RetrogradeAnalysis", Performance::RetrogradeAnalysis},
+        {"Performance::RandomGames", Performance::RandomGames},
 };
 
 int RunAll() {
@@ -140,13 +212,14 @@ int RunAll() {
 }
 
 int Run(const std::string& id) {
-  if (!Tests.contains(id)) {
+  const auto& tests = PerformanceTests.contains(id) ? PerformanceTests : Tests;
+  if (!tests.contains(id)) {
     std::cerr << std::format("Unknown test \"{}\"!", id) << std::endl;
     return 1;
   }
 
   try {
-    return Tests.at(id)();
+    return tests.at(id)();
   } catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
     return 1;
@@ -159,6 +232,10 @@ void Init() {
   StateGraph::Vertex::Init();
   StateGraph::Edge::Init();
   StateGraph::RetrogradeAnalysis::Init();
+  StateGraph::VertexTable::Init();
+  OpeningBook::Init();
+  GameRecord::Init();
+  PositionDatabase::Init();
 }
 
 }  // namespace Tests
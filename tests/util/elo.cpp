@@ -0,0 +1,55 @@
+#include "elo.h"
+
+#include <cmath>
+#include <format>
+#include <iostream>
+
+#include "../../src/util/elo.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace Elo {
+
+static bool AssertNear(const double value, const double expected) {
+  if (std::abs(value - expected) < 0.05) return true;
+
+  std::cerr << std::format("Expected {:.2f}; got {:.2f}!", expected, value)
+            << std::endl;
+  return false;
+}
+
+int FromScore() {
+  if (!AssertNear(::Elo::FromScore(0.5), 0.0)) return Fail;
+  if (!AssertNear(::Elo::FromScore(0.75), 190.85)) return Fail;
+  if (!AssertNear(::Elo::FromScore(0.25), -190.85)) return Fail;
+
+  if (!std::isinf(::Elo::FromScore(1.0)) || ::Elo::FromScore(1.0) < 0.0) {
+    std::cerr << "Perfect score is not infinitely better!" << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int FromResults() {
+  // 75% score over 100 games, with a standard error of about 0.04
+  const ::Elo::Estimate estimate = ::Elo::FromResults(70, 10, 20);
+  const double score = 0.75;
+  const double error =
+      std::sqrt((0.7 * 0.0625 + 0.1 * 0.0625 + 0.2 * 0.5625) / 100.0);
+
+  if (!AssertNear(estimate.Difference, ::Elo::FromScore(score))) return Fail;
+  if (!AssertNear(estimate.Lower, ::Elo::FromScore(score - 1.96 * error)))
+    return Fail;
+  if (!AssertNear(estimate.Upper, ::Elo::FromScore(score + 1.96 * error)))
+    return Fail;
+
+  const ::Elo::Estimate even = ::Elo::FromResults(10, 0, 10);
+  if (!AssertNear(even.Difference, 0.0)) return Fail;
+  if (!AssertNear(even.Lower, -even.Upper)) return Fail;
+
+  return Pass;
+}
+
+}  // namespace Elo
+}  // namespace Tests
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace Tests {
+namespace Elo {
+
+int FromScore();
+int FromResults();
+
+}  // namespace Elo
+}  // namespace Tests
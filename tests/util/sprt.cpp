@@ -0,0 +1,100 @@
+#include "sprt.h"
+
+#include <cmath>
+#include <format>
+#include <iostream>
+
+#include "../../src/util/sprt.h"
+#include "../assertEqual.h"
+
+namespace Tests {
+namespace Sprt {
+
+using namespace ::Sprt;
+
+static constexpr Parameters TemplateParameters{
+    .Elo0 = 0.0, .Elo1 = 10.0, .Alpha = 0.05, .Beta = 0.05};
+
+static bool AssertNear(const double value, const double expected) {
+  if (std::abs(value - expected) < 0.001) return true;
+
+  std::cerr << std::format("Expected {:.3f}; got {:.3f}!", expected, value)
+            << std::endl;
+  return false;
+}
+
+static Test MakeTest(const std::array<size_t, 5>& pentanomial) {
+  Test test(TemplateParameters);
+  for (size_t halfPoints = 0; halfPoints < pentanomial.size(); halfPoints++) {
+    for (size_t pair = 0; pair < pentanomial[halfPoints]; pair++)
+      test.AddPair(halfPoints);
+  }
+
+  return test;
+}
+
+int Bounds() {
+  const Test test(TemplateParameters);
+
+  if (!AssertNear(test.GetLowerBound(), -std::log(19.0))) return Fail;
+  if (!AssertNear(test.GetUpperBound(), std::log(19.0))) return Fail;
+
+  return Pass;
+}
+
+int LogLikelihoodRatio() {
+  if (!AssertNear(Test(TemplateParameters).GetLogLikelihoodRatio(), 0.0))
+    return Fail;
+
+  const Test test = MakeTest({10, 20, 40, 20, 15});
+  if (test.GetPairCount() != 105) {
+    std::cerr << std::format("Expected 105 pairs; got {}!",
+                             test.GetPairCount())
+              << std::endl;
+    return Fail;
+  }
+
+  if (!AssertNear(test.GetLogLikelihoodRatio(), 0.303)) return Fail;
+
+  return Pass;
+}
+
+int GetResult() {
+  if (MakeTest({10, 20, 40, 20, 15}).GetResult() != Result::Continue) {
+    std::cerr << "Test concluded too early!" << std::endl;
+    return Fail;
+  }
+
+  if (MakeTest({100, 200, 400, 300, 300}).GetResult() != Result::AcceptH1) {
+    std::cerr << "Test did not accept a clearly stronger strategy!"
+              << std::endl;
+    return Fail;
+  }
+
+  if (MakeTest({300, 300, 400, 200, 100}).GetResult() != Result::AcceptH0) {
+    std::cerr << "Test did not reject a clearly weaker strategy!"
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+int UniformTally() {
+  if (MakeTest({0, 0, 0, 0, 10}).GetResult() != Result::AcceptH1) {
+    std::cerr << "Test did not accept a strategy that won every pair!"
+              << std::endl;
+    return Fail;
+  }
+
+  if (MakeTest({0, 0, 10, 0, 0}).GetResult() != Result::AcceptH0) {
+    std::cerr << "Test did not reject a strategy that drew every pair!"
+              << std::endl;
+    return Fail;
+  }
+
+  return Pass;
+}
+
+}  // namespace Sprt
+}  // namespace Tests
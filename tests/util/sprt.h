@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Tests {
+namespace Sprt {
+
+int Bounds();
+int LogLikelihoodRatio();
+int GetResult();
+int UniformTally();
+
+}  // namespace Sprt
+}  // namespace Tests